@@ -0,0 +1,76 @@
+//=====================================
+//  StarterPack i2cQueue Example
+//=====================================
+//
+//  i2cQueue
+//  --------
+//  - read a sensor one transaction per loop()
+//  - disconnected sensor is not retried on every loop, see i2cHelper Recovery
+//    disconnect/reconnect VCC, GND, SDA, SCL
+//  - on ESP32, queue.startTask() moves the transfers off loop() entirely
+
+#include <StarterPack.h>
+#include <Utility/i2cQueue.h>
+
+using namespace StarterPack;
+
+#define i2cAddress  0x36
+#define dataAddress 0x0C
+
+i2cHelper iHelper( i2cAddress );
+i2cQueue  queue( iHelper );
+
+uint8_t reg = dataAddress;
+uint8_t data[2];
+i2cQueue::transaction sample;
+
+void onSample( i2cQueue::transaction &t ) {
+    if ( t.result != i2cHelper::ERR_I2C_OK )
+        Serial.println( i2cHelper::errorMessage( t.result ) );
+    else
+        Serial.println( ( data[0] << 8 ) | data[1] );
+}
+
+//
+// SETUP
+//
+
+    void setup() {
+        Serial.begin( 115200 );
+        while( !Serial );
+
+        Wire.begin();
+        iHelper.setTimeoutInMs( 100 );
+
+        sample.i2cAddress  = i2cAddress;
+        sample.writeData   = &reg;
+        sample.writeLength = 1;
+        sample.readBuffer  = data;
+        sample.readLength  = 2;
+        sample.onComplete  = onSample;
+    }
+
+//
+// LOOP
+//
+
+    uint32_t loops = 0;
+
+    void loop() {
+        loops++;
+
+        if ( sample.isDone() )
+            queue.submit( sample );
+        queue.poll();
+
+        if ( queue.recoverIfHasError() )
+            Serial.println( "i2c recovered" );
+
+        static uint32_t lastReport = millis();
+        if ( millis() - lastReport >= 1000 ) {
+            lastReport = millis();
+            Serial.print( "loops/s " );
+            Serial.println( loops );
+            loops = 0;
+        }
+    }
@@ -0,0 +1,125 @@
+//  Host Arduino Shim
+//  -----------------
+//  - minimal Arduino core so library headers build on a PC, ex. for tests and benchmarks
+//  - not a board emulation, only what the library uses
+//  - single source file programs, Serial and Wire are defined in the headers
+//
+//  Time
+//
+//      millis()/micros() run from the host clock
+//      delay()/delayMicroseconds() return at once and move the clock forward instead
+//      so code waiting for hardware runs at full speed, but still sees the time pass
+//
+//      hostArduino::advanceInUs( us )      move clock forward, ex. time of bytes on a bus
+//
+//  Pins
+//
+//      pinMode()/digitalWrite()/digitalRead() are sent to a pin device, if any
+//
+//      struct myPins : hostArduino::pinDevice { ... };
+//      myPins pins;
+//      hostArduino::attachPins( pins );    // see hostLCD.h for HD44780 on a parallel bus
+//
+//  Build
+//
+//      g++ -std=gnu++11 -I extras/host -I src test.cpp -lpthread
+//      see Makefile
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "Print.h"
+
+#define HIGH            1
+#define LOW             0
+#define INPUT           0
+#define OUTPUT          1
+#define INPUT_PULLUP    2
+#define OUTPUT_OPEN_DRAIN 3
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+namespace hostArduino {
+
+    //
+    // CLOCK
+    //
+
+    inline std::atomic<uint64_t> &skippedInUs() {
+        static std::atomic<uint64_t> skipped { 0 };
+        return skipped;
+    }
+
+    inline uint64_t clockInUs() {
+        using namespace std::chrono;
+        static const steady_clock::time_point start = steady_clock::now();
+        uint64_t real = duration_cast<microseconds>( steady_clock::now() - start ).count();
+        return real + skippedInUs().load();
+    }
+
+    inline void advanceInUs( uint64_t us ) {
+        skippedInUs() += us;
+    }
+
+    //
+    // PINS
+    //
+
+    class pinDevice {
+        public:
+            virtual ~pinDevice() {}
+            virtual void pinMode( uint8_t pin, uint8_t mode ) {}
+            virtual void pinWrite( uint8_t pin, uint8_t value ) = 0;
+            virtual int  pinRead( uint8_t pin ) = 0;
+    };
+
+    inline pinDevice *&pins() {
+        static pinDevice *device = nullptr;
+        return device;
+    }
+
+    inline void attachPins( pinDevice &device ) { pins() = &device; }
+    inline void detachPins() { pins() = nullptr; }
+
+}
+
+inline uint32_t micros() { return (uint32_t) hostArduino::clockInUs(); }
+inline uint32_t millis() { return (uint32_t) ( hostArduino::clockInUs() / 1000 ); }
+
+inline void delay( uint32_t ms )              { hostArduino::advanceInUs( (uint64_t) ms * 1000 ); }
+inline void delayMicroseconds( uint32_t us )  { hostArduino::advanceInUs( us ); }
+inline void yield()                           { std::this_thread::yield(); }
+
+inline void pinMode( uint8_t pin, uint8_t mode ) {
+    if ( hostArduino::pins() != nullptr ) hostArduino::pins()->pinMode( pin, mode );
+}
+inline void digitalWrite( uint8_t pin, uint8_t value ) {
+    if ( hostArduino::pins() != nullptr ) hostArduino::pins()->pinWrite( pin, value );
+}
+inline int digitalRead( uint8_t pin ) {
+    if ( hostArduino::pins() == nullptr ) return LOW;
+    return hostArduino::pins()->pinRead( pin );
+}
+inline int analogRead( uint8_t pin ) { return 0; }
+
+inline long random( long howBig )             { return howBig <= 0 ? 0 : rand() % howBig; }
+inline long random( long howSmall, long howBig ) { return howSmall + random( howBig - howSmall ); }
+
+class HardwareSerial : public Stream {
+    public:
+        void begin( unsigned long baud ) {}
+        size_t write( uint8_t c ) override { return fputc( c, stdout ) == EOF ? 0 : 1; }
+        using Print::write;
+        int available() override { return 0; }
+        int read() override { return -1; }
+        int peek() override { return -1; }
+};
+
+static HardwareSerial Serial;
@@ -0,0 +1,156 @@
+//==============================
+//  StarterPack LCD Simulated Benchmark
+//==============================
+//
+//  host build, no LCD needed
+//  LCD_i2c drives HD44780Sim thru the Wire shim, see hostLCD.h
+//
+//      make -C extras/host bench
+//
+//  for each scenario, per frame:
+//  - bus bytes        i2c bytes incl. address, sent by LCD_i2c
+//  - sim us           time on the simulated bus, incl. driver delays and cpu time
+//  - cpu us           time spent by this processor
+//
+//  scenarios:
+//  - full redraw      every character changes
+//  - counter          1 digit changes
+//  - scroll           scrollDisplayUp() of a full screen
+//
+//  direct = LCD_i2c without buffering, same drawing calls
+
+#include <Arduino.h>
+#include "hostLCD.h"
+#include <LCD/LCD_i2c.h>
+#include <LCD/LCDBuffered.h>
+
+using namespace StarterPack;
+
+HD44780Sim sim;
+HD44780Backpack backpack( sim );
+LCD_i2c lcdSim( 0x27 );
+LCDBuffered lcd( lcdSim, 0, 10 );
+
+const uint8_t COLS = 20, ROWS = 4;
+const uint16_t FRAMES = 50;
+
+//
+// SCENARIOS
+//
+
+void fullRedraw( LCDInterface &out, uint16_t frame ) {
+    for( uint8_t r = 0 ; r < ROWS ; r++ ) {
+        out.setCursor( 0, r );
+        for( uint8_t c = 0 ; c < COLS ; c++ )
+            out.write( 'A' + ( frame + r + c ) % 26 );
+    }
+}
+
+void counter( LCDInterface &out, uint16_t frame ) {
+    out.setCursor( 0, 0 );
+    out.print( "Count: " );
+    out.print( 1000 + frame % 10 );
+}
+
+void scroll( LCDInterface &out, uint16_t frame ) {
+    // direct has no scroll, redraw shifted text
+    for( uint8_t r = 0 ; r < ROWS ; r++ ) {
+        out.setCursor( 0, r );
+        out.print( "line " );
+        out.print( frame + r );
+        out.print( "          " );
+    }
+}
+
+//
+// RUN
+//
+
+// cpu time only, host clock also moves with bus and delays
+uint32_t cpuMicros() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>( steady_clock::now().time_since_epoch() ).count();
+}
+
+void report( const char *name, uint32_t cpuInUs, uint32_t simStart ) {
+    Serial.print( name );
+    Serial.print( "  bus bytes " ); Serial.print( sim.busBytes / FRAMES );
+    Serial.print( "  sim us "    ); Serial.print( ( micros() - simStart ) / FRAMES );
+    Serial.print( "  cpu us "    ); Serial.print( cpuInUs / FRAMES );
+    if ( sim.busyViolations != 0 ) {
+        Serial.print( "  LOST " ); Serial.print( sim.busyViolations );
+    }
+    Serial.println();
+}
+
+void runDirect( const char *name, void (*draw)( LCDInterface &, uint16_t ) ) {
+    lcdSim.clear();
+    sim.resetCounters();
+    uint32_t simStart = micros();
+    uint32_t start = cpuMicros();
+    for( uint16_t i = 0 ; i < FRAMES ; i++ )
+        draw( lcdSim, i );
+    report( name, cpuMicros() - start, simStart );
+}
+
+void startBuffered() {
+    // direct runs bypassed the buffer, start both from blank
+    lcdSim.clear();
+    lcd.clear();
+    lcd.reset();
+}
+
+void runBuffered( const char *name, void (*draw)( LCDInterface &, uint16_t ) ) {
+    startBuffered();
+    sim.resetCounters();
+    uint32_t simStart = micros();
+    uint32_t start = cpuMicros();
+    for( uint16_t i = 0 ; i < FRAMES ; i++ ) {
+        draw( lcd, i );
+        lcd.refresh();
+    }
+    report( name, cpuMicros() - start, simStart );
+}
+
+void runBufferedScroll() {
+    startBuffered();
+    for( uint8_t r = 0 ; r < ROWS ; r++ ) {
+        lcd.setCursor( 0, r );
+        lcd.print( "line " );
+        lcd.print( r );
+    }
+    lcd.refresh();
+    sim.resetCounters();
+    uint32_t simStart = micros();
+    uint32_t start = cpuMicros();
+    for( uint16_t i = 0 ; i < FRAMES ; i++ ) {
+        lcd.scrollDisplayUp();
+        lcd.setCursor( 0, ROWS - 1 );
+        lcd.print( "line " );
+        lcd.print( i + ROWS );
+        lcd.refresh();
+    }
+    report( "buffered scroll ", cpuMicros() - start, simStart );
+}
+
+void run( uint32_t frequency ) {
+    lcdSim.setFrequency( frequency );
+    Serial.println();
+    Serial.print( "*** " ); Serial.print( frequency / 1000 ); Serial.println( "kHz, per frame ***" );
+    runDirect(   "direct full     ", fullRedraw );
+    runBuffered( "buffered full   ", fullRedraw );
+    runDirect(   "direct counter  ", counter );
+    runBuffered( "buffered counter", counter );
+    runDirect(   "direct scroll   ", scroll );
+    runBufferedScroll();
+}
+
+int main() {
+    Wire.attach( 0x27, backpack );
+    sim.setGeometry( COLS, ROWS );
+    lcd.begin( COLS, ROWS );
+    run( 100000 );
+    run( 400000 );
+    run( 1000000 );
+    return 0;
+}
@@ -0,0 +1,101 @@
+//  Host Print/Stream Shim
+//  ----------------------
+//  - same interface as Arduino's Print and Stream, see Arduino.h
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+
+    public:
+
+        virtual ~Print() {}
+
+        virtual size_t write( uint8_t value ) = 0;
+
+        virtual size_t write( const uint8_t *buffer, size_t size ) {
+            size_t n = 0;
+            while( size-- ) n += write( *buffer++ );
+            return n;
+        }
+        size_t write( const char *str ) {
+            if ( str == nullptr ) return 0;
+            return write( (const uint8_t *) str, strlen( str ) );
+        }
+        size_t write( const char *buffer, size_t size ) {
+            return write( (const uint8_t *) buffer, size );
+        }
+
+        virtual void flush() {}
+
+        int  getWriteError()   { return writeError; }
+        void clearWriteError() { writeError = 0; }
+
+        size_t print( const char *str )   { return write( str ); }
+        size_t print( char c )            { return write( (uint8_t) c ); }
+        size_t print( int value,           int base = DEC ) { return print( (long) value, base ); }
+        size_t print( unsigned int value,  int base = DEC ) { return print( (unsigned long) value, base ); }
+        size_t print( unsigned char value, int base = DEC ) { return print( (unsigned long) value, base ); }
+        size_t print( long value, int base = DEC ) {
+            if ( base == DEC && value < 0 ) return print( '-' ) + printNumber( - (unsigned long) value, base );
+            return printNumber( (unsigned long) value, base );
+        }
+        size_t print( unsigned long value, int base = DEC ) { return printNumber( value, base ); }
+        size_t print( double value, int digits = 2 ) {
+            char buffer[32];
+            snprintf( buffer, sizeof( buffer ), "%.*f", digits, value );
+            return write( buffer );
+        }
+
+        size_t println() { return write( "\r\n" ); }
+        template<typename T>
+        size_t println( T value ) { size_t n = print( value ); return n + println(); }
+        template<typename T>
+        size_t println( T value, int format ) { size_t n = print( value, format ); return n + println(); }
+
+    protected:
+
+        void setWriteError( int error = 1 ) { writeError = error; }
+
+    private:
+
+        int writeError = 0;
+
+        size_t printNumber( unsigned long value, int base ) {
+            char buffer[ 8 * sizeof( long ) + 1 ];
+            char *p = buffer + sizeof( buffer ) - 1;
+            *p = 0;
+            if ( base < 2 ) base = 10;
+            do {
+                uint8_t digit = value % base;
+                *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+                value /= base;
+            } while( value != 0 );
+            return write( p );
+        }
+
+};
+
+class Stream : public Print {
+
+    public:
+
+        virtual int available() = 0;
+        virtual int read() = 0;
+        virtual int peek() = 0;
+
+        void setTimeout( unsigned long timeout ) { streamTimeout = timeout; }
+        unsigned long getTimeout() { return streamTimeout; }
+
+    protected:
+
+        unsigned long streamTimeout = 1000;
+
+};
@@ -0,0 +1,191 @@
+//  Host Wire Shim
+//  --------------
+//  - TwoWire for host builds, devices are objects attached to an address
+//  - address without device does not acknowledge, same as empty bus
+//  - each byte moves the host clock by its time on the bus, see setClock()
+//
+//  To Use
+//
+//      struct myDevice : hostArduino::i2cDevice { ... };
+//      myDevice dev;
+//      Wire.attach( 0x36, dev );
+//      ... library code using Wire ...
+//
+//  Device
+//
+//      bool receive( value )           master wrote a byte, false to not acknowledge
+//      uint8_t transmit()              master reads a byte
+//      void stop()                     end of transmission
+//
+//  Faults
+//
+//      setLatencyInUs( address, us )   each transfer to address blocks this long, real time
+//      setNack( address, true )        address does not acknowledge, as if disconnected
+//
+//  Counters
+//
+//      transmissions, requests, busBytes
+
+#pragma once
+#include "Arduino.h"
+#include <map>
+#include <set>
+
+#if !defined(BUFFER_LENGTH)
+    #define BUFFER_LENGTH 32
+#endif
+
+namespace hostArduino {
+
+    class i2cDevice {
+        public:
+            virtual ~i2cDevice() {}
+            virtual bool    receive( uint8_t value ) = 0;
+            virtual uint8_t transmit() { return 0xFF; }
+            virtual void    stop() {}
+    };
+
+}
+
+class TwoWire : public Stream {
+
+    public:
+
+        void begin() {}
+        void begin( uint8_t address ) {}
+        void end() {}
+
+        void setClock( uint32_t frequency ) {
+            // 9 bits per byte with ACK
+            byteInNs = 9000000000ULL / ( frequency == 0 ? 100000 : frequency );
+        }
+
+        void attach( uint8_t address, hostArduino::i2cDevice &device ) { devices[ address ] = &device; }
+        void detach( uint8_t address ) { devices.erase( address ); }
+
+        void setLatencyInUs( uint8_t address, uint32_t us ) { latencyInUs[ address ] = us; }
+        void setNack( uint8_t address, bool nack ) {
+            if ( nack ) nacked.insert( address ); else nacked.erase( address );
+        }
+
+        uint32_t transmissions = 0;
+        uint32_t requests      = 0;
+        uint32_t busBytes      = 0;     // including address bytes
+
+    //
+    // WRITE
+    //
+    public:
+
+        void beginTransmission( uint8_t address ) {
+            txAddress = address;
+            txLength = 0;
+            txOverflow = false;
+            transmitting = true;
+        }
+        inline void beginTransmission( int address ) { beginTransmission( (uint8_t) address ); }
+
+        size_t write( uint8_t value ) override {
+            if ( !transmitting ) return 0;
+            if ( txLength >= BUFFER_LENGTH ) {
+                txOverflow = true;
+                setWriteError();
+                return 0;
+            }
+            txBuffer[ txLength++ ] = value;
+            return 1;
+        }
+        using Print::write;
+
+        uint8_t endTransmission( bool sendStop = true ) {
+            // 0 ok, 1 too long, 2 address nack, 3 data nack
+            transmitting = false;
+            transmissions++;
+            if ( txOverflow ) return 1;
+            busTime( 1 );
+            hostArduino::i2cDevice *device = find( txAddress );
+            if ( device == nullptr ) return 2;
+            stall( txAddress );
+            for( uint8_t i = 0 ; i < txLength ; i++ ) {
+                busTime( 1 );
+                if ( !device->receive( txBuffer[i] ) ) {
+                    device->stop();
+                    return 3;
+                }
+            }
+            if ( sendStop ) device->stop();
+            return 0;
+        }
+        inline uint8_t endTransmission( uint8_t sendStop ) { return endTransmission( (bool) sendStop ); }
+
+    //
+    // READ
+    //
+    public:
+
+        uint8_t requestFrom( uint8_t address, uint8_t quantity, uint8_t sendStop = true ) {
+            requests++;
+            rxLength = 0;
+            rxIndex = 0;
+            if ( quantity > BUFFER_LENGTH ) quantity = BUFFER_LENGTH;
+            busTime( 1 );
+            hostArduino::i2cDevice *device = find( address );
+            if ( device == nullptr ) return 0;
+            stall( address );
+            for( uint8_t i = 0 ; i < quantity ; i++ ) {
+                busTime( 1 );
+                rxBuffer[ rxLength++ ] = device->transmit();
+            }
+            if ( sendStop ) device->stop();
+            return rxLength;
+        }
+        inline uint8_t requestFrom( int address, int quantity, int sendStop = 1 ) {
+            return requestFrom( (uint8_t) address, (uint8_t) quantity, (uint8_t) sendStop );
+        }
+
+        int available() override { return rxLength - rxIndex; }
+        int read() override { return rxIndex < rxLength ? rxBuffer[ rxIndex++ ] : -1; }
+        int peek() override { return rxIndex < rxLength ? rxBuffer[ rxIndex ] : -1; }
+
+    private:
+
+        std::map<uint8_t, hostArduino::i2cDevice *> devices;
+        std::map<uint8_t, uint32_t> latencyInUs;
+        std::set<uint8_t> nacked;
+
+        uint8_t txAddress = 0;
+        uint8_t txBuffer[ BUFFER_LENGTH ];
+        uint8_t txLength = 0;
+        bool    txOverflow = false;
+        bool    transmitting = false;
+
+        uint8_t rxBuffer[ BUFFER_LENGTH ];
+        uint8_t rxLength = 0;
+        uint8_t rxIndex = 0;
+
+        uint64_t byteInNs = 90000;      // 100kHz
+        uint64_t pendingNs = 0;
+
+        hostArduino::i2cDevice *find( uint8_t address ) {
+            if ( nacked.count( address ) != 0 ) return nullptr;
+            auto it = devices.find( address );
+            return it == devices.end() ? nullptr : it->second;
+        }
+
+        void stall( uint8_t address ) {
+            // slow device, caller really waits
+            auto it = latencyInUs.find( address );
+            if ( it != latencyInUs.end() && it->second != 0 )
+                std::this_thread::sleep_for( std::chrono::microseconds( it->second ) );
+        }
+
+        void busTime( uint8_t bytes ) {
+            busBytes += bytes;
+            pendingNs += bytes * byteInNs;
+            hostArduino::advanceInUs( pendingNs / 1000 );
+            pendingNs %= 1000;
+        }
+
+};
+
+static TwoWire Wire;
@@ -0,0 +1,125 @@
+//  Host LCD Simulator Wiring
+//  -------------------------
+//  - connects HD44780Sim to the Wire and pin shims
+//    so the real LCD_i2c and LCD_wired drive it unchanged
+//  - simulator clock follows the host clock, bus bytes and driver delays included
+//
+//  I2C Backpack (PCF8574)
+//
+//      HD44780Sim sim;
+//      HD44780Backpack backpack( sim );
+//      Wire.attach( 0x27, backpack );
+//      LCD_i2c lcd( 0x27 );
+//      lcd.begin( 20, 4 );
+//
+//  Parallel Bus
+//
+//      HD44780Sim sim;
+//      HD44780Pins pins( sim, rs, rw, en, d4, d5, d6, d7 );  // rw = HD44780Pins::NOT_WIRED if hardwired low
+//      hostArduino::attachPins( pins );
+//      LCD_wired lcd( rs, en, d4, d5, d6, d7 );
+//      lcd.begin( 20, 4 );
+//
+//  setGeometry() of the simulator is set by the sketch, same as wiring a real LCD
+
+#pragma once
+#include "Arduino.h"
+#include "Wire.h"
+#include <LCD/HD44780Sim.h>
+
+//
+// I2C BACKPACK
+//
+
+class HD44780Backpack : public hostArduino::i2cDevice {
+
+        StarterPack::HD44780Sim *sim;
+        bool started = false;
+
+    public:
+
+        HD44780Backpack( StarterPack::HD44780Sim &sim ) : sim( &sim ) {}
+
+        bool receive( uint8_t value ) override {
+            sim->simTimeInUs = micros();
+            if ( !started ) {
+                // address byte counted once per transmission
+                sim->addressWrite();
+                started = true;
+            }
+            sim->expanderWrite( value );
+            return true;
+        }
+
+        void stop() override { started = false; }
+
+};
+
+//
+// PARALLEL BUS
+//
+
+class HD44780Pins : public hostArduino::pinDevice {
+
+        StarterPack::HD44780Sim *sim;
+
+        static const uint8_t PIN_COUNT = 64;
+        uint8_t pinState[ PIN_COUNT ];
+
+        uint8_t pinRS, pinRW, pinE;
+        uint8_t pinData[8];     // D0-D7, NOT_WIRED for D0-D3 if 4-bit
+
+    public:
+
+        static const uint8_t NOT_WIRED = 0xFF;
+
+        HD44780Pins( StarterPack::HD44780Sim &sim, uint8_t rs, uint8_t rw, uint8_t enable,
+                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 )
+            : HD44780Pins( sim, rs, rw, enable, NOT_WIRED, NOT_WIRED, NOT_WIRED, NOT_WIRED, d4, d5, d6, d7 ) {}
+
+        HD44780Pins( StarterPack::HD44780Sim &sim, uint8_t rs, uint8_t rw, uint8_t enable,
+                     uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3,
+                     uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 ) : sim( &sim ) {
+            memset( pinState, 0, sizeof( pinState ) );
+            pinRS = rs; pinRW = rw; pinE = enable;
+            uint8_t d[8] = { d0, d1, d2, d3, d4, d5, d6, d7 };
+            memcpy( pinData, d, sizeof( pinData ) );
+        }
+
+        void pinWrite( uint8_t pin, uint8_t value ) override {
+            if ( pin >= PIN_COUNT ) return;
+            pinState[pin] = value;
+            if ( !isLcdPin( pin ) ) return;
+            sim->simTimeInUs = micros();
+            sim->pinsWrite( state( pinRS ), state( pinRW ), state( pinE ), dataBus() );
+        }
+
+        int pinRead( uint8_t pin ) override {
+            if ( pin >= PIN_COUNT ) return LOW;
+            sim->simTimeInUs = micros();
+            for( uint8_t i = 0 ; i < 8 ; i++ )
+                if ( pinData[i] == pin ) return ( sim->pinsRead() >> i ) & 1;
+            return pinState[pin];
+        }
+
+    private:
+
+        inline bool state( uint8_t pin ) {
+            return pin < PIN_COUNT && pinState[pin] != LOW;
+        }
+
+        uint8_t dataBus() {
+            uint8_t data = 0;
+            for( uint8_t i = 0 ; i < 8 ; i++ )
+                if ( state( pinData[i] ) ) data |= 1 << i;
+            return data;
+        }
+
+        bool isLcdPin( uint8_t pin ) {
+            if ( pin == pinRS || pin == pinRW || pin == pinE ) return true;
+            for( uint8_t i = 0 ; i < 8 ; i++ )
+                if ( pinData[i] == pin ) return true;
+            return false;
+        }
+
+};
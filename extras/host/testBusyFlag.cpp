@@ -0,0 +1,116 @@
+//  LCD_wired busy flag polling against HD44780Sim
+//  - polling ends as soon as the LCD is ready, nothing is lost
+//  - LCD much slower than datasheet worst case: times out, then reverts to fixed delays
+//  - busy flag stuck high (R/W not wired, DB7 floating): same, each wait bounded
+
+#define LCD_READ_WRITE_MODE
+
+#include <Arduino.h>
+#include "hostLCD.h"
+#include <LCD/LCD_wired.h>
+#include <assert.h>
+
+using namespace StarterPack;
+
+const uint8_t RS = 8, RW = 10, EN = 9, D4 = 4, D5 = 5, D6 = 6, D7 = 7;
+
+// DB7 reads high whatever the LCD drives
+class floatingPins : public HD44780Pins {
+    public:
+        bool floating = false;
+        using HD44780Pins::HD44780Pins;
+        int pinRead( uint8_t pin ) override {
+            if ( floating && pin == D7 ) return HIGH;
+            return HD44780Pins::pinRead( pin );
+        }
+};
+
+HD44780Sim sim;
+floatingPins pins( sim, RS, RW, EN, D4, D5, D6, D7 );
+LCD_wired lcd( RS, RW, EN, D4, D5, D6, D7 );
+
+uint32_t timeToDraw() {
+    uint32_t start = micros();
+    lcd.clear();
+    for( uint8_t i = 0 ; i < 40 ; i++ ) lcd.write( 'A' + i % 26 );
+    lcd.setCursor( 0, 1 );
+    return micros() - start;
+}
+
+void testPolling() {
+    // same screen with fixed delays and with busy flag
+    lcd.useBusyFlag( false );
+    sim.resetCounters();
+    uint32_t fixedInUs = timeToDraw();
+    assert( sim.busyViolations == 0 );
+
+    lcd.useBusyFlag();
+    sim.resetCounters();
+    uint32_t busyInUs = timeToDraw();
+    printf( "fixed %uus, busy flag %uus, timeouts %u\n", fixedInUs, busyInUs, lcd.busyFlagTimeouts );
+    assert( sim.busyViolations == 0 );
+    assert( lcd.isUsingBusyFlag() && lcd.busyFlagTimeouts == 0 );
+
+    char text[21];
+    sim.getRow( 0, text );
+    assert( strcmp( text, "ABCDEFGHIJKLMNOPQRST" ) == 0 );
+
+    // LCD faster than worst case, polling gains the difference
+    sim.executionTimePercent = 50;
+    sim.resetCounters();
+    uint32_t fastInUs = timeToDraw();
+    printf( "faster lcd: busy flag %uus\n", fastInUs );
+    assert( sim.busyViolations == 0 && lcd.busyFlagTimeouts == 0 );
+    assert( fastInUs < fixedInUs * 3 / 4 );
+    sim.executionTimePercent = 100;
+
+    // status read: address counter after cursor move, busy right after a command
+    lcd.setCursor( 5, 1 );
+    uint8_t status = lcd.readStatus();
+    assert( ( status & 0x7F ) == 0x45 );
+    assert( status & 0x80 );
+}
+
+void testSlowLcd() {
+    // busy past worst case, proceed anyway, revert after busyFlagMaxTimeouts in a row
+    lcd.useBusyFlag();
+    lcd.busyFlagTimeouts = 0;
+    sim.executionTimePercent = 1000;
+    for( uint8_t i = 0 ; i < LCD_wired::busyFlagMaxTimeouts ; i++ ) {
+        assert( lcd.isUsingBusyFlag() );
+        lcd.write( 'x' );
+    }
+    lcd.write( 'y' );
+    printf( "slow lcd: timeouts %u, using busy flag %d\n", lcd.busyFlagTimeouts, lcd.isUsingBusyFlag() );
+    assert( lcd.busyFlagTimeouts == LCD_wired::busyFlagMaxTimeouts );
+    assert( !lcd.isUsingBusyFlag() );
+    sim.executionTimePercent = 100;
+}
+
+void testStuckFlag() {
+    // each wait ends after worst case, not hung
+    lcd.useBusyFlag();
+    lcd.busyFlagTimeouts = 0;
+    pins.floating = true;
+    uint32_t start = micros();
+    for( uint8_t i = 0 ; i < 10 ; i++ ) lcd.write( 'z' );
+    uint32_t elapsed = micros() - start;
+    pins.floating = false;
+    printf( "stuck flag: %uus for 10 writes, timeouts %u\n", elapsed, lcd.busyFlagTimeouts );
+    assert( !lcd.isUsingBusyFlag() );
+    assert( lcd.busyFlagTimeouts == LCD_wired::busyFlagMaxTimeouts );
+    assert( elapsed < 10 * 200 );
+}
+
+int main() {
+    // keep output if an assert aborts
+    setvbuf( stdout, nullptr, _IONBF, 0 );
+    hostArduino::attachPins( pins );
+    sim.setGeometry( 20, 4 );
+    lcd.begin( 20, 4 );
+    testPolling();
+    testSlowLcd();
+    testStuckFlag();
+    printf( "testBusyFlag ok\n" );
+    return 0;
+}
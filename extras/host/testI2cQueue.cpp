@@ -0,0 +1,128 @@
+//  i2cQueue against a register device on the Wire shim
+//  - data read back matches, from poll() and from background task
+//  - slow device blocks the task, not the caller
+//  - device not acknowledging: error reported, task recovers, back online once it answers
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Utility/i2cQueue.h>
+#include <assert.h>
+
+using namespace StarterPack;
+
+const uint8_t ADDRESS = 0x36;
+
+// first byte written sets register pointer, auto increments
+class registerDevice : public hostArduino::i2cDevice {
+    public:
+        uint8_t regs[256];
+        uint8_t pointer = 0;
+        bool    first = true;
+
+        registerDevice() {
+            for( uint16_t i = 0 ; i < 256 ; i++ ) regs[i] = i ^ 0x5A;
+        }
+        bool receive( uint8_t value ) override {
+            if ( first ) pointer = value; else regs[ pointer++ ] = value;
+            first = false;
+            return true;
+        }
+        uint8_t transmit() override { return regs[ pointer++ ]; }
+        void stop() override { first = true; }
+};
+
+registerDevice device;
+i2cHelper helper( ADDRESS );
+i2cQueue  queue( helper );
+
+uint8_t reg = 0x0C;
+uint8_t data[2];
+i2cQueue::transaction sample;
+
+uint32_t realMs() {
+    using namespace std::chrono;
+    return (uint32_t) duration_cast<milliseconds>( steady_clock::now().time_since_epoch() ).count();
+}
+
+bool waitDone( i2cQueue::transaction &t, uint32_t timeoutInMs ) {
+    uint32_t start = realMs();
+    while( !t.isDone() ) {
+        if ( realMs() - start > timeoutInMs ) return false;
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    return true;
+}
+
+bool dataIsValid() {
+    return data[0] == ( 0x0C ^ 0x5A ) && data[1] == ( 0x0D ^ 0x5A );
+}
+
+void testPoll() {
+    memset( data, 0, sizeof( data ) );
+    assert( queue.submit( sample ) );
+    assert( !queue.poll() );
+    assert( sample.isDone() && sample.result == i2cHelper::ERR_I2C_OK );
+    assert( dataIsValid() );
+}
+
+void testTaskDoesNotBlock() {
+    Wire.setLatencyInUs( ADDRESS, 20000 );
+    assert( queue.startTask() );
+    memset( data, 0, sizeof( data ) );
+    uint32_t start = realMs();
+    assert( queue.submit( sample ) );
+    uint32_t callerInMs = realMs() - start;
+    assert( waitDone( sample, 1000 ) );
+    uint32_t totalInMs = realMs() - start;
+    queue.stopTask();
+    Wire.setLatencyInUs( ADDRESS, 0 );
+    printf( "slow device: caller %ums, transaction %ums\n", callerInMs, totalInMs );
+    assert( callerInMs < 5 && totalInMs >= 40 );
+    assert( sample.result == i2cHelper::ERR_I2C_OK && dataIsValid() );
+}
+
+void testNackAndRecovery() {
+    assert( queue.startTask() );
+    assert( !queue.recoverIfHasError() );
+
+    // not acknowledging, device goes offline
+    Wire.setNack( ADDRESS, true );
+    assert( queue.submit( sample ) );
+    assert( waitDone( sample, 1000 ) );
+    assert( sample.result != i2cHelper::ERR_I2C_OK );
+    printf( "nack: %s\n", i2cHelper::errorMessage( sample.result ) );
+
+    // answers again, retried until back online
+    Wire.setNack( ADDRESS, false );
+    memset( data, 0, sizeof( data ) );
+    uint32_t start = realMs();
+    do {
+        assert( realMs() - start < 2000 );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+        assert( queue.submit( sample ) );
+        assert( waitDone( sample, 1000 ) );
+    } while( sample.result != i2cHelper::ERR_I2C_OK );
+    queue.stopTask();
+
+    i2cHelper::deviceHealth *d = helper.getDeviceHealth( ADDRESS );
+    printf( "recovered after %ums, recoveries %u, skipped %u\n", realMs() - start, d->recoveries, d->skipped );
+    assert( d != nullptr && !d->isOffline() && d->recoveries >= 1 );
+    assert( helper.lastError == i2cHelper::ERR_I2C_OK );
+    assert( dataIsValid() );
+}
+
+int main() {
+    // keep output if an assert aborts
+    setvbuf( stdout, nullptr, _IONBF, 0 );
+    Wire.attach( ADDRESS, device );
+    sample.i2cAddress  = ADDRESS;
+    sample.writeData   = &reg;
+    sample.writeLength = 1;
+    sample.readBuffer  = data;
+    sample.readLength  = 2;
+    testPoll();
+    testTaskDoesNotBlock();
+    testNackAndRecovery();
+    printf( "testI2cQueue ok\n" );
+    return 0;
+}
@@ -0,0 +1,130 @@
+//  i2cHelper recovery and backoff, device disconnected then reconnected
+//  - recovery reports true only once device is due, so LCD re-init and resend reach the LCD
+//  - without any recovery call, offline device is still retried and comes back
+//  - device failing after register address of a read stays offline, retry time keeps growing
+
+#include <Arduino.h>
+#include "hostLCD.h"
+#include <LCD/LCD_i2c.h>
+#include <LCD/LCDBuffered.h>
+#include <assert.h>
+
+using namespace StarterPack;
+
+bool rowIs( HD44780Sim &sim, uint8_t row, const char *expected ) {
+    char text[41];
+    sim.getRow( row, text );
+    if ( strcmp( text, expected ) == 0 ) return true;
+    printf( "row %d [%s] expected [%s]\n", row, text, expected );
+    return false;
+}
+
+void testLcdRecovery() {
+    HD44780Sim sim;
+    HD44780Backpack backpack( sim );
+    Wire.attach( 0x27, backpack );
+    sim.setGeometry( 20, 4 );
+    LCD_i2c lcd( 0x27 );
+    LCDBuffered buffered( lcd, 0, 10 );
+    buffered.begin( 20, 4 );
+    buffered.print( "before" );
+    buffered.refresh();
+    assert( rowIs( sim, 0, "before              " ) );
+
+    // VCC disconnected, LCD back to power on state
+    Wire.setNack( 0x27, true );
+    sim.powerOn();
+    buffered.setCursor( 0, 1 );
+    buffered.print( "while off" );
+    buffered.refresh();
+    Wire.setNack( 0x27, false );
+
+    // offline until retry time, no re-init yet
+    // refresh in between may take the retry, recovery still re-inits and resends after it
+    assert( !buffered.recoverIfHasError() );
+    uint16_t waits = 0;
+    while( !buffered.recoverIfHasError() ) {
+        assert( ++waits < 1000 );
+        delay( 1 );
+        buffered.refresh();
+    }
+    printf( "lcd recovered after %u ms\n", waits );
+    assert( !sim.eightBitMode && sim.twoLines && sim.displayOn );
+    assert( rowIs( sim, 0, "before              " ) );
+    assert( rowIs( sim, 1, "while off           " ) );
+    assert( sim.busyViolations == 0 );
+    Wire.detach( 0x27 );
+}
+
+class registerDevice : public hostArduino::i2cDevice {
+    public:
+        bool receive( uint8_t value ) override { return true; }
+        uint8_t transmit() override { return 0x42; }
+};
+
+// acknowledges register address, gone before data is read
+class dropsBeforeRead : public hostArduino::i2cDevice {
+    public:
+        uint8_t address;
+        dropsBeforeRead( uint8_t address ) : address( address ) {}
+        bool receive( uint8_t value ) override {
+            Wire.setNack( address, true );
+            return true;
+        }
+};
+
+void testRetryWithoutRecovery() {
+    const uint8_t ADDRESS = 0x41;
+    registerDevice device;
+    Wire.attach( ADDRESS, device );
+    i2cHelper helper( ADDRESS );
+    uint8_t value;
+    Wire.setNack( ADDRESS, true );
+    assert( helper.readOneByte( 0x00, value ) == i2cHelper::ERR_I2C_ADDR_NACK );
+    assert( helper.readOneByte( 0x00, value ) == i2cHelper::ERR_I2C_OFFLINE );
+    Wire.setNack( ADDRESS, false );
+
+    // never recovered, lastError stays as is, device still retried when due
+    uint16_t waits = 0;
+    while( helper.readOneByte( 0x00, value ) != i2cHelper::ERR_I2C_OK ) {
+        assert( ++waits < 1000 );
+        delay( 1 );
+    }
+    printf( "back without recovery after %u ms\n", waits );
+    assert( !helper.getDeviceHealth( ADDRESS )->isOffline() );
+    assert( helper.getDeviceHealth( ADDRESS )->recoveries == 0 );
+    Wire.detach( ADDRESS );
+}
+
+void testBackoffOnFailedRead() {
+    const uint8_t ADDRESS = 0x40;
+    dropsBeforeRead device( ADDRESS );
+    Wire.attach( ADDRESS, device );
+    i2cHelper helper( ADDRESS );
+    helper.recoveryMinDelayInMs = 10;
+    uint8_t value;
+    uint16_t lastBackoff = 0;
+    for( uint8_t attempt = 0 ; attempt < 4 ; attempt++ ) {
+        Wire.setNack( ADDRESS, false );
+        i2cHelper::deviceHealth *d = helper.getDeviceHealth( ADDRESS );
+        if ( d != nullptr ) delay( d->nextAttempt - millis() + 1 );
+        assert( helper.readOneByte( 0x00, value ) == i2cHelper::ERR_I2C_REQUEST );
+        d = helper.getDeviceHealth( ADDRESS );
+        printf( "failed read %u: backoff %u ms\n", attempt, d->backoffInMs );
+        assert( d->isOffline() && d->backoffInMs > lastBackoff );
+        lastBackoff = d->backoffInMs;
+        helper.clearLastError();
+    }
+    Wire.setNack( ADDRESS, false );
+    Wire.detach( ADDRESS );
+}
+
+int main() {
+    // keep output if an assert aborts
+    setvbuf( stdout, nullptr, _IONBF, 0 );
+    testLcdRecovery();
+    testRetryWithoutRecovery();
+    testBackoffOnFailedRead();
+    printf( "testI2cRecovery ok\n" );
+    return 0;
+}
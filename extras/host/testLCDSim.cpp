@@ -0,0 +1,152 @@
+//  LCD_i2c and LCD_wired against HD44780Sim
+//  - text and glyphs end up where expected
+//  - no instruction is sent while the simulated LCD is still busy, at any bus speed
+
+#include <Arduino.h>
+#include "hostLCD.h"
+#include <LCD/LCD_i2c.h>
+#include <LCD/LCD_wired.h>
+#include <LCD/LCDBuffered.h>
+#include <LCD/LCDBufferedStatic.h>
+#include <assert.h>
+
+using namespace StarterPack;
+
+static const uint8_t glyphA[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+bool rowIs( HD44780Sim &sim, uint8_t row, const char *expected ) {
+    char text[41];
+    sim.getRow( row, text );
+    if ( strcmp( text, expected ) == 0 ) return true;
+    printf( "row %d [%s] expected [%s]\n", row, text, expected );
+    return false;
+}
+
+void drawAndCheck( LCDInterface &lcd, HD44780Sim &sim ) {
+    lcd.clear();
+    lcd.setCursor( 3, 2 ); lcd.print( "hello" );
+    lcd.setCursor( 0, 3 ); lcd.write( (const uint8_t *) "0123456789ABCDEFGHIJ", 20 );
+    lcd.createChar( 1, glyphA );
+    lcd.setCursor( 19, 0 ); lcd.write( 1 );
+    assert( rowIs( sim, 0, "                   \x01" ) );
+    assert( rowIs( sim, 1, "                    " ) );
+    assert( rowIs( sim, 2, "   hello            " ) );
+    assert( rowIs( sim, 3, "0123456789ABCDEFGHIJ" ) );
+    assert( memcmp( sim.glyph( 1 ), glyphA, 8 ) == 0 );
+    assert( sim.twoLines && sim.displayOn && !sim.eightBitMode );
+}
+
+void testI2c() {
+    HD44780Sim sim;
+    HD44780Backpack backpack( sim );
+    Wire.attach( 0x27, backpack );
+    sim.setGeometry( 20, 4 );
+    LCD_i2c lcd( 0x27 );
+    const uint32_t speeds[] = { 100000, 400000, 1000000, 3400000 };
+    for( uint32_t frequency : speeds ) {
+        lcd.setFrequency( frequency );
+        lcd.begin( 20, 4 );
+        sim.resetCounters();
+        drawAndCheck( lcd, sim );
+        printf( "i2c %7u Hz: bus bytes %u, lost %u\n", frequency, sim.busBytes, sim.busyViolations );
+        assert( sim.busyViolations == 0 );
+    }
+    // buffered on top, only changes are sent
+    LCDBuffered buffered( lcd, 0, 10 );
+    buffered.begin( 20, 4 );
+    buffered.print( "buffered" );
+    buffered.refresh();
+    assert( rowIs( sim, 0, "buffered            " ) );
+    sim.resetCounters();
+    buffered.setCursor( 0, 0 ); buffered.print( "buffere!" );
+    buffered.refresh();
+    assert( rowIs( sim, 0, "buffere!            " ) );
+    assert( sim.dataWrites == 1 && sim.busyViolations == 0 );
+    Wire.detach( 0x27 );
+}
+
+void testSharedHelper() {
+    // frequency set on shared helper, or on Wire only (unknown to the LCD)
+    HD44780Sim sim;
+    HD44780Backpack backpack( sim );
+    Wire.attach( 0x27, backpack );
+    sim.setGeometry( 20, 4 );
+    i2cHelper helper( 0x27 );
+    helper.setFrequency( 1000000 );
+    LCD_i2c lcd( helper, 0x27 );
+    lcd.begin( 20, 4 );
+    sim.resetCounters();
+    drawAndCheck( lcd, sim );
+    printf( "shared helper 1MHz: bus bytes %u, lost %u\n", sim.busBytes, sim.busyViolations );
+    assert( sim.busyViolations == 0 );
+
+    Wire.setClock( 3400000 );
+    LCD_i2c unknown( 0x27 );
+    unknown.begin( 20, 4 );
+    sim.resetCounters();
+    drawAndCheck( unknown, sim );
+    printf( "unknown clock at 3.4MHz: bus bytes %u, lost %u\n", sim.busBytes, sim.busyViolations );
+    assert( sim.busyViolations == 0 );
+    Wire.setClock( 100000 );
+    Wire.detach( 0x27 );
+}
+
+void testCanvasResize() {
+    // canvas too large for static storage: refused, display keeps working
+    HD44780Sim sim;
+    HD44780Backpack backpack( sim );
+    Wire.attach( 0x27, backpack );
+    sim.setGeometry( 20, 4 );
+    LCD_i2c lcd( 0x27 );
+    lcd.setFrequency( 400000 );
+    lcd.begin( 20, 4 );
+    LCDBufferedStatic<20,4> fixed( lcd, 0, 10 );
+    fixed.print( "static" );
+    assert( fixed.addPriorityRegion( 0, 0, 5, 0 ) );
+    assert( !fixed.setCanvasSize( 40, 8 ) );
+    assert( fixed.maxColumns == 20 && fixed.maxRows == 4 && fixed.getPriorityRegionCount() == 1 );
+    fixed.print( " ok" );
+    fixed.refresh();
+    assert( rowIs( sim, 0, "static ok           " ) );
+
+    // heap canvas grows then shrinks, regions and viewport clipped
+    LCDBuffered buffered( lcd, 0, 10 );
+    assert( buffered.addPriorityRegion( 0, 0, 5, 0 ) );
+    assert( buffered.setCanvasSize( 40, 8 ) );
+    assert( buffered.addPriorityRegion( 30, 6, 39, 7 ) );
+    buffered.setViewport( 20, 4 );
+    assert( buffered.setCanvasSize( 30, 6 ) );
+    assert( buffered.maxColumns == 30 && buffered.maxRows == 6 );
+    assert( buffered.getPriorityRegionCount() == 1 );
+    assert( buffered.getViewportColumn() == 10 && buffered.getViewportRow() == 2 );
+    buffered.setViewport( 0, 0 );
+    buffered.print( "heap canvas" );   // covers "static ok", LCD is shared with first one
+    buffered.refresh();
+    assert( rowIs( sim, 0, "heap canvas         " ) );
+    Wire.detach( 0x27 );
+}
+
+void testWired() {
+    HD44780Sim sim;
+    HD44780Pins pins( sim, 8, HD44780Pins::NOT_WIRED, 9, 4, 5, 6, 7 );
+    hostArduino::attachPins( pins );
+    sim.setGeometry( 20, 4 );
+    LCD_wired lcd( 8, 9, 4, 5, 6, 7 );
+    lcd.begin( 20, 4 );
+    sim.resetCounters();
+    drawAndCheck( lcd, sim );
+    printf( "wired: pin updates %u, lost %u\n", sim.busBytes, sim.busyViolations );
+    assert( sim.busyViolations == 0 );
+    hostArduino::detachPins();
+}
+
+int main() {
+    // keep output if an assert aborts
+    setvbuf( stdout, nullptr, _IONBF, 0 );
+    testI2c();
+    testSharedHelper();
+    testCanvasResize();
+    testWired();
+    printf( "testLCDSim ok\n" );
+    return 0;
+}
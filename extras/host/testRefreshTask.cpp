@@ -0,0 +1,87 @@
+//  LCDBuffered refresh task (std::thread) against HD44780Sim
+//  - frames published from main thread while task sends, including row scrolls
+//  - after stopping, LCD shows exactly the last frame
+//  - built with -fsanitize=thread too, see Makefile, to guard the frame handoff
+
+#include <Arduino.h>
+#include "hostLCD.h"
+#include <LCD/LCD_i2c.h>
+#include <LCD/LCDBuffered.h>
+#include <assert.h>
+
+using namespace StarterPack;
+
+const uint8_t COLUMNS = 20, ROWS = 4;
+
+// what the LCD should show, same operations as on the buffer
+char model[ ROWS ][ COLUMNS + 1 ];
+
+void modelPrint( uint8_t col, uint8_t row, const char *text ) {
+    for( ; *text != 0 && col < COLUMNS ; text++ ) model[row][col++] = *text;
+}
+
+void modelScrollUp() {
+    for( uint8_t r = 0 ; r < ROWS - 1 ; r++ ) memcpy( model[r], model[r+1], COLUMNS );
+    memset( model[ ROWS - 1 ], ' ', COLUMNS );
+}
+
+bool rowsMatch( HD44780Sim &sim ) {
+    bool ok = true;
+    char text[ COLUMNS + 1 ];
+    for( uint8_t r = 0 ; r < ROWS ; r++ ) {
+        sim.getRow( r, text );
+        if ( strcmp( text, model[r] ) == 0 ) continue;
+        printf( "row %d [%s] expected [%s]\n", r, text, model[r] );
+        ok = false;
+    }
+    return ok;
+}
+
+int main() {
+    // keep output if an assert aborts
+    setvbuf( stdout, nullptr, _IONBF, 0 );
+    HD44780Sim sim;
+    HD44780Backpack backpack( sim );
+    Wire.attach( 0x27, backpack );
+    sim.setGeometry( COLUMNS, ROWS );
+    LCD_i2c lcd( 0x27 );
+    lcd.setFrequency( 400000 );
+    LCDBuffered buffered( lcd, 0, 10 );
+    buffered.begin( COLUMNS, ROWS );
+    for( uint8_t r = 0 ; r < ROWS ; r++ ) {
+        memset( model[r], ' ', COLUMNS );
+        model[r][COLUMNS] = 0;
+    }
+
+    assert( buffered.startRefreshTask() );
+    const uint16_t FRAMES = 5000;
+    char text[ COLUMNS + 1 ];
+    for( uint16_t f = 0 ; f < FRAMES ; f++ ) {
+        buffered.pauseUpdate();
+        uint8_t row = f % ROWS;
+        snprintf( text, sizeof( text ), "frame %5u", f );
+        buffered.setCursor( 0, row );
+        buffered.print( text );
+        modelPrint( 0, row, text );
+        snprintf( text, sizeof( text ), "%02u", f % 100 );
+        buffered.setCursor( COLUMNS - 2, ( row + 1 ) % ROWS );
+        buffered.print( text );
+        modelPrint( COLUMNS - 2, ( row + 1 ) % ROWS, text );
+        if ( f % 7 == 0 ) {
+            buffered.scrollDisplayUp();
+            modelScrollUp();
+        }
+        buffered.resumeUpdate();
+        // let task pick up some frames midway, skip others
+        if ( f % 16 == 0 ) std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+    }
+    buffered.stopRefreshTask();
+    printf( "frames %u, bus bytes %u, lost %u\n", FRAMES, sim.busBytes, sim.busyViolations );
+
+    // last frame may still be pending, send it from here
+    buffered.refresh();
+    assert( rowsMatch( sim ) );
+    assert( sim.busyViolations == 0 );
+    printf( "testRefreshTask ok\n" );
+    return 0;
+}
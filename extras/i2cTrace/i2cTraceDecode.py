@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+#  i2cHelper Trace Decoder
+#  -----------------------
+#  decodes output of i2cHelper::dumpTrace(), see i2cHelper.h
+#  input may contain other text (ex. Serial prints), dump is found by "I2CT"
+#
+#  Usage
+#
+#      python3 i2cTraceDecode.py dump.bin             # file, ex. saved from terminal program
+#      python3 i2cTraceDecode.py /dev/ttyUSB0 115200  # serial port, needs pyserial
+#      ... --summary                                  # per device totals only
+#
+#  Output
+#
+#      each transfer: start (relative to first), duration, address, R/W, length, data, error
+#      per device   : transfers, errors by ERROR_NO, bus time, share of traced time
+
+import struct
+import sys
+
+MAGIC = b"I2CT"
+
+# by dump version, fields before data: start, duration, address|read, length, error, dataCount
+ENTRY_FORMATS = {
+    1: "<IIBBBB",   # 1 byte length
+    2: "<IIBHBB",
+}
+
+ERRORS = {
+    0: "ok", 1: "buffer", 2: "addr nack", 3: "data nack", 4: "twi", 5: "timeout",
+    101: "write", 102: "endtrans", 103: "request", 104: "timeout2", 105: "offline",
+}
+
+
+def read_input(args):
+    if len(args) >= 2 and not args[1].startswith("-") and args[1].isdigit():
+        import serial  # pyserial
+        with serial.Serial(args[0], int(args[1]), timeout=2) as port:
+            data = b""
+            while True:
+                chunk = port.read(4096)
+                if not chunk:
+                    return data
+                data += chunk
+    with open(args[0], "rb") as f:
+        return f.read()
+
+
+def decode(data):
+    # returns list of dumps, each ( header, entries )
+    dumps = []
+    pos = data.find(MAGIC)
+    while pos >= 0 and pos + 16 <= len(data):
+        version, entry_size, count, total, now = struct.unpack_from("<BBHII", data, pos + 4)
+        if version not in ENTRY_FORMATS:
+            pos = data.find(MAGIC, pos + 4)
+            continue
+        entry_format = ENTRY_FORMATS[version]
+        fixed = struct.calcsize(entry_format)
+        start = pos + 16
+        entries = []
+        for i in range(count):
+            off = start + i * entry_size
+            if off + entry_size > len(data):
+                break
+            begin, duration, addr, length, error, data_count = struct.unpack_from(entry_format, data, off)
+            payload = data[off + fixed: off + fixed + min(data_count, entry_size - fixed)]
+            entries.append({
+                "start": begin, "duration": duration,
+                "addr": addr & 0x7F, "read": bool(addr & 0x80),
+                "length": length, "error": error, "data": payload,
+            })
+        dumps.append(({"count": count, "total": total, "now": now}, entries))
+        pos = data.find(MAGIC, start + count * entry_size)
+    return dumps
+
+
+def print_dump(header, entries, summary_only):
+    print("entries %d, recorded %d, overwritten %d" % (
+        header["count"], header["total"], header["total"] - header["count"]))
+    if not entries:
+        return
+    first = entries[0]["start"]
+    if not summary_only:
+        print("%10s %8s  addr  rw   len  %-12s %s" % ("start us", "dur us", "data", "error"))
+        for e in entries:
+            print("%10d %8d  0x%02X  %s %5d  %-12s %s" % (
+                (e["start"] - first) & 0xFFFFFFFF, e["duration"], e["addr"],
+                "R " if e["read"] else " W", e["length"], e["data"].hex(" "),
+                "" if e["error"] == 0 else ERRORS.get(e["error"], str(e["error"]))))
+    last = entries[-1]
+    span = ((last["start"] - first) & 0xFFFFFFFF) + last["duration"]
+    devices = {}
+    for e in entries:
+        d = devices.setdefault(e["addr"], {"transfers": 0, "busUs": 0, "errors": {}})
+        d["transfers"] += 1
+        d["busUs"] += e["duration"]
+        if e["error"] != 0:
+            name = ERRORS.get(e["error"], str(e["error"]))
+            d["errors"][name] = d["errors"].get(name, 0) + 1
+    print()
+    print("traced %d us" % span)
+    print("addr  transfers    bus us  share  errors")
+    for addr in sorted(devices, key=lambda a: -devices[a]["busUs"]):
+        d = devices[addr]
+        share = 100.0 * d["busUs"] / span if span else 0
+        errors = ", ".join("%s %d" % kv for kv in sorted(d["errors"].items()))
+        print("0x%02X  %9d %9d %5.1f%%  %s" % (addr, d["transfers"], d["busUs"], share, errors))
+
+
+def main():
+    args = [a for a in sys.argv[1:] if a != "--summary"]
+    if not args:
+        print(__doc__ or "usage: i2cTraceDecode.py file | port baud [--summary]")
+        sys.exit(1)
+    dumps = decode(read_input(args))
+    if not dumps:
+        print("no trace found")
+        sys.exit(1)
+    for header, entries in dumps:
+        print_dump(header, entries, "--summary" in sys.argv)
+        print()
+
+
+if __name__ == "__main__":
+    main()
@@ -6,11 +6,22 @@
 // base class, needed only if developing variants
 // #include <LCD/LCDBuffered.h>
 
+// buffered with compile time sized storage, no heap
+// #include <LCD/LCDBufferedStatic.h>
+
+// several buffered LCDs sharing one time budget, same contents on several LCDs
+// #include <LCD/LCDBufferedGroup.h>
+// #include <LCD/LCDMirror.h>
+
 // wired connection type
 // seldom used so don't include by default
 // #include <LCD/LCD_wired.h>
 // #include <LCD/LCDBuffered_wired.h>
 
+// terminal using ANSI escape sequences, no hardware needed
+// #include <LCD/LCD_ansi.h>
+// #include <LCD/LCDBuffered_ansi.h>
+
 // i2c LCD display, non-buffered and buffered
 #include <LCD/LCD_i2c.h>
 #include <LCD/LCDBuffered_i2c.h>
@@ -0,0 +1,342 @@
+//  HD44780 Simulator
+//  -----------------
+//  - model of the LCD controller, not a driver
+//  - DDRAM, CGRAM, address counter, entry mode, display shift, 4/8-bit interface
+//  - simulated clock with execution time of each instruction
+//    instruction sent while still busy is ignored and counted, as real LCD would
+//  - fed from pins of PCF8574 expander (i2c backpack) or parallel bus
+//    so drivers can be tested without hardware
+//
+//  To Use
+//
+//      HD44780Sim sim;
+//      sim.setGeometry( 20, 4 );
+//
+//      sim.simTimeInUs = now;                  // before each input, clock of the bus
+//      sim.expanderWrite( pins );              // each byte written to PCF8574
+//      sim.pinsWrite( rs, rw, en, data );      // parallel bus, data on D0-D7 (D4-D7 if 4-bit)
+//      data = sim.pinsRead();                  // parallel bus, driven by LCD while RW and EN are high
+//
+//      sim.getRow( 0, text );                  // what is shown, after display shift
+//      sim.busBytes, sim.busyViolations
+//
+//  Host Builds
+//
+//      the real LCD_i2c/LCD_wired drive the simulator thru Wire and pin shims
+//      see extras/host/hostLCD.h
+//
+//  Timing (datasheet, 270kHz)
+//
+//      clear, home          1520us
+//      other instructions   37us
+//      data read/write      37us, busy flag clears then (4us address update after it is not modelled)
+//
+//      executionTimePercent    above 100 for slower LCD, ex. low oscillator frequency
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+namespace StarterPack {
+
+class HD44780Sim {
+
+    public:
+
+        // contents
+        uint8_t ddram[ 0x80 ];
+        uint8_t cgram[ 64 ];
+        uint8_t addressCounter = 0;
+        bool    addressIsCgram = false;
+
+        // modes
+        bool entryIncrement = true;
+        bool entryShift     = false;
+        bool displayOn      = false;
+        bool cursorOn       = false;
+        bool blinkOn        = false;
+        bool eightBitMode   = true;     // power on state
+        bool twoLines       = false;
+        int8_t displayShift = 0;
+        bool backlight      = false;    // expander only
+
+        // counters
+        uint32_t simTimeInUs    = 0;    // simulated clock, set by caller
+        uint32_t busBytes       = 0;    // bytes seen on i2c, or pin updates on parallel bus
+        uint32_t instructions   = 0;
+        uint32_t dataWrites     = 0;
+        uint32_t busyViolations = 0;    // ignored, sent before previous one finished
+
+        uint16_t executionTimePercent = 100;
+
+        HD44780Sim() { powerOn(); }
+
+        void powerOn() {
+            memset( ddram, ' ', sizeof( ddram ) );
+            memset( cgram, 0, sizeof( cgram ) );
+            addressCounter = 0; addressIsCgram = false;
+            entryIncrement = true; entryShift = false;
+            displayOn = false; cursorOn = false; blinkOn = false;
+            eightBitMode = true; twoLines = false; displayShift = 0;
+            nibblePending = false;
+            readPending = false; lastRead = false;
+            lastPins = 0;
+            busyUntil = simTimeInUs;
+        }
+
+        void resetCounters() {
+            busBytes = 0; instructions = 0; dataWrites = 0; busyViolations = 0;
+        }
+
+        // glass size, row addresses same as LCD_HD44780
+        void setGeometry( uint8_t columns, uint8_t rows ) {
+            this->columns = columns;
+            this->rows = rows;
+        }
+
+        inline bool isBusy() { return (int32_t) ( busyUntil - simTimeInUs ) > 0; }
+
+    //
+    // INPUT
+    //
+    public:
+
+        // PCF8574 pins: bit 0 RS, bit 1 RW, bit 2 EN, bit 3 backlight, bits 4-7 D4-D7
+        void expanderWrite( uint8_t pins ) {
+            busBytes++;
+            // latched on EN high to low
+            if ( ( lastPins & 0x04 ) && !( pins & 0x04 ) && !( pins & 0x02 ) )
+                latch( pins & 0x01, lastPins & 0xF0 );
+            lastPins = pins;
+            backlight = pins & 0x08;
+        }
+        // start of i2c transmission, address byte
+        inline void addressWrite() {
+            busBytes++;
+        }
+
+        // parallel bus, 4-bit wiring has data on D4-D7 (bits 4-7)
+        void pinsWrite( bool rs, bool rw, bool en, uint8_t data ) {
+            busBytes++;
+            if ( rw ) {
+                // LCD drives data pins from EN high
+                if ( !lastEnable && en ) readLatch( rs );
+                lastEnable = en;
+                lastRead = true;
+                return;
+            }
+            if ( lastRead ) {
+                // back to write, next read starts with high nibble
+                lastRead = false;
+                readPending = false;
+            }
+            if ( lastEnable && !en ) latch( rs, lastData );
+            lastEnable = en;
+            lastData = data;
+        }
+        inline void pinsWrite( bool rs, bool en, uint8_t data ) {
+            // R/W hardwired to low
+            pinsWrite( rs, false, en, data );
+        }
+
+        // data pins while reading, 4-bit wiring has data on D4-D7 (bits 4-7)
+        inline uint8_t pinsRead() { return readBus; }
+
+        // read status with RW high: busy flag and address counter
+        uint8_t readStatus() {
+            return ( isBusy() ? 0x80 : 0 ) | ( addressCounter & 0x7F );
+        }
+
+    //
+    // OUTPUT
+    //
+    public:
+
+        uint8_t columns = 16, rows = 2;
+
+        // character code shown at glass position
+        uint8_t charAt( uint8_t col, uint8_t row ) {
+            uint8_t base = ( row & 1 ) ? 0x40 : 0x00;
+            if ( row >= 2 ) base += columns;
+            if ( twoLines ) {
+                // each line is 40 characters, display shift rotates within line
+                int16_t offset = ( base & 0x3F ) + col - displayShift;
+                offset %= 40; if ( offset < 0 ) offset += 40;
+                return ddram[ ( base & 0x40 ) + offset ];
+            }
+            int16_t offset = base + col - displayShift;
+            offset %= 80; if ( offset < 0 ) offset += 80;
+            return ddram[ offset ];
+        }
+
+        // text of row, buffer must hold columns + 1
+        void getRow( uint8_t row, char *buffer ) {
+            for( uint8_t i = 0 ; i < columns ; i++ )
+                buffer[i] = charAt( i, row );
+            buffer[ columns ] = 0;
+        }
+
+        inline const uint8_t *glyph( uint8_t charCode ) {
+            return cgram + ( charCode & 0x07 ) * 8;
+        }
+
+    //
+    // CONTROLLER
+    //
+    private:
+
+        uint32_t busyUntil = 0;
+        bool nibblePending = false;
+        uint8_t nibbleHigh = 0;
+        uint8_t lastPins = 0;
+        bool lastEnable = false;
+        uint8_t lastData = 0;
+
+        // reading, 4-bit sends high nibble then low nibble of same value
+        bool lastRead = false;
+        bool readPending = false;
+        uint8_t readValue = 0;
+        uint8_t readBus = 0;
+
+        void readLatch( bool rs ) {
+            if ( eightBitMode ) {
+                readBus = rs ? readData() : readStatus();
+                return;
+            }
+            if ( !readPending ) {
+                readValue = rs ? readData() : readStatus();
+                readBus = readValue & 0xF0;
+                readPending = true;
+                return;
+            }
+            readBus = readValue << 4;
+            readPending = false;
+        }
+
+        uint8_t readData() {
+            // ignored if busy, same as writes
+            if ( isBusy() ) {
+                busyViolations++;
+                return 0;
+            }
+            uint8_t value;
+            if ( addressIsCgram ) {
+                value = cgram[ addressCounter & 0x3F ];
+                addressCounter = ( addressCounter + ( entryIncrement ? 1 : -1 ) ) & 0x3F;
+            } else {
+                value = ddram[ addressCounter ];
+                moveAddress( entryIncrement );
+            }
+            busyUntil = simTimeInUs + scaled( 37 );
+            return value;
+        }
+
+        void latch( bool rs, uint8_t bus ) {
+            if ( eightBitMode ) {
+                // 4-bit wiring before switching, D0-D3 read as 0
+                execute( rs, bus );
+                return;
+            }
+            if ( !nibblePending ) {
+                nibbleHigh = bus & 0xF0;
+                nibblePending = true;
+                return;
+            }
+            nibblePending = false;
+            execute( rs, nibbleHigh | ( bus >> 4 ) );
+        }
+
+        void execute( bool rs, uint8_t value ) {
+            if ( isBusy() ) {
+                busyViolations++;
+                return;
+            }
+            uint16_t timeInUs = 37;
+            if ( rs ) {
+                writeData( value );
+                dataWrites++;
+            } else {
+                instructions++;
+                if ( executeInstruction( value ) ) timeInUs = 1520;
+            }
+            busyUntil = simTimeInUs + scaled( timeInUs );
+        }
+
+        inline uint32_t scaled( uint16_t timeInUs ) {
+            return (uint32_t) timeInUs * executionTimePercent / 100;
+        }
+
+        bool executeInstruction( uint8_t value ) {
+            // return true if long instruction
+            if ( value & 0x80 ) {
+                addressCounter = value & 0x7F;
+                addressIsCgram = false;
+            } else if ( value & 0x40 ) {
+                addressCounter = value & 0x3F;
+                addressIsCgram = true;
+            } else if ( value & 0x20 ) {
+                eightBitMode = value & 0x10;
+                twoLines = value & 0x08;
+                nibblePending = false;
+            } else if ( value & 0x10 ) {
+                bool right = value & 0x04;
+                if ( value & 0x08 )
+                    displayShift += right ? 1 : -1;
+                else
+                    moveAddress( right );
+            } else if ( value & 0x08 ) {
+                displayOn = value & 0x04;
+                cursorOn  = value & 0x02;
+                blinkOn   = value & 0x01;
+            } else if ( value & 0x04 ) {
+                entryIncrement = value & 0x02;
+                entryShift     = value & 0x01;
+            } else if ( value & 0x02 ) {
+                addressCounter = 0; addressIsCgram = false;
+                displayShift = 0;
+                return true;
+            } else if ( value & 0x01 ) {
+                memset( ddram, ' ', sizeof( ddram ) );
+                addressCounter = 0; addressIsCgram = false;
+                displayShift = 0;
+                entryIncrement = true;
+                return true;
+            }
+            return false;
+        }
+
+        void writeData( uint8_t value ) {
+            if ( addressIsCgram ) {
+                cgram[ addressCounter & 0x3F ] = value & 0x1F;
+                addressCounter = ( addressCounter + ( entryIncrement ? 1 : -1 ) ) & 0x3F;
+                return;
+            }
+            ddram[ addressCounter ] = value;
+            moveAddress( entryIncrement );
+            if ( entryShift ) displayShift += entryIncrement ? -1 : 1;
+        }
+
+        void moveAddress( bool increment ) {
+            // 2 lines: 00-27 and 40-67, wraps to other line
+            // 1 line : 00-4F
+            uint8_t a = addressCounter;
+            if ( twoLines ) {
+                if ( increment ) {
+                    if      ( a == 0x27 ) a = 0x40;
+                    else if ( a == 0x67 ) a = 0x00;
+                    else a++;
+                } else {
+                    if      ( a == 0x00 ) a = 0x67;
+                    else if ( a == 0x40 ) a = 0x27;
+                    else a--;
+                }
+            } else {
+                if ( increment ) a = ( a == 0x4F ) ? 0 : a + 1;
+                else             a = ( a == 0x00 ) ? 0x4F : a - 1;
+            }
+            addressCounter = a;
+        }
+
+};
+
+}
@@ -61,6 +61,28 @@
 //      setUpdateThrottleInMs( timeInMs )     time between actual updates
 //      uint16_t getUpdateThrottleInMs        get current throttle
 //
+//      setCanvasSize( cols, rows )           buffer larger than LCD, see CANVAS / VIEWPORT
+//                                            false if it does not fit, previous canvas and contents kept
+//      setViewport( col, row )               pan canvas, costs one compare of visible area
+//
+//      uint16_t getPendingCount()            changed characters not yet sent, estimate
+//
+//      addPriorityRegion( c1, r1, c2, r2 )   send changes in region first on every update()
+//      clearPriorityRegions()                regions are kept by begin()/setCanvasSize(), clipped to new size
+//      uint8_t getPriorityRegionCount()
+//
+//      createChar( id, charmap )             queued, uploaded by update() together with text
+//                                            skipped if LCD already has same bitmap
+//
+//      setAdaptiveUpdateInUs( timeInUs )     measure LCD speed and limit each update() to timeInUs instead
+//      refreshTiming getRefreshTiming()      measured us per character/cursor move, last update duration
+//
+//   Statistics
+//
+//      refreshStats getRefreshStats()        snapshot of counters, see refreshStats
+//      resetRefreshStats()                   restart counting
+//      printRefreshStats( out )              ex. printRefreshStats( Serial ) or printRefreshStats( lcd )
+//
 //      ex. lcd.setUpdateThrottleInMs(100);
 //          lcd.updateDurationInMs = 50;
 //          void loop() {
@@ -78,9 +100,11 @@
 //        
 //      bool pauseUpdate()                      pause updates until resumed
 //      void resumeUpdate()                     updates can continue
-//      void setSemaphoreLockTimeoutInMs( t )   timeout for locks
+//      void setSemaphoreLockTimeoutInMs( t )   ignored, frame handoff is lock free
 //      useSingleBuffer()                       increased performance but no multicore support
 //      useDoubleBuffer()                       required for multicore support, default
+//      startRefreshTask( core )                send updates from own task (ESP32, host builds)
+//      stopRefreshTask()
 //
 //      ESP32         single buffer is faster
 //      Arduino Uno   same speed
@@ -113,7 +137,12 @@
 #include <stdint.h>
 
 #include <LCD/LCDInterface.h>
-#include <Utility/spSemaphore.h>
+#include <Utility/spAtomic.h>
+
+#if !defined(ARDUINO)
+    #include <thread>
+    #include <chrono>
+#endif
 
 namespace StarterPack {
 
@@ -134,9 +163,10 @@ class LCDBuffered : public LCDInterface {
         // - fast write()
         // - slower updates, check if there are no changes
         //
-        // use approach (2)
-        // - assume many write()
-        // - calling update is on available processor time
+        // use mix of both
+        // - write() only widens span of changed columns per row (2 compares)
+        // - update only compares characters within changed spans
+        //   so no changes costs almost nothing
 
         LCDInterface *lcd;
         bool mustDeletedLCD = true;
@@ -144,13 +174,20 @@ class LCDBuffered : public LCDInterface {
     public:
 
         ~LCDBuffered() {
-            if ( userBuffer != nullptr ) delete userBuffer;
-            if ( screenData != nullptr ) delete screenData;
-            if ( btsBufferCore != nullptr ) delete btsBufferCore;
+            stopRefreshTask();
+            freeBuffers();
             if ( mustDeletedLCD ) delete lcd;
         }
 
         inline bool isBuffered() override { return true; }
+
+        bool isCharCodeInUse( uint8_t charCode ) override {
+            // user side, what will be on screen after next update
+            charCode &= 0x07;
+            for( uint16_t i = 0 ; i < bufferSize ; i++ )
+                if ( ( (uint8_t) userBuffer[i] & 0xF7 ) == charCode ) return true;
+            return false;
+        }
         // inline void displayAll() override { updateAllNow(); }
 
         LCDBuffered() {}
@@ -171,6 +208,28 @@ class LCDBuffered : public LCDInterface {
             this->updateDurationInMs = updateDurationInMs;
         }
 
+    protected:
+
+        struct dirtySpan;
+
+        // use storage from derived class instead of heap, see LCDBufferedStatic
+        // - storage     : 4 x storageSize characters + 3 x ( CGRAM_SIZE + storageRows )
+        // - spanStorage : SPANS_PER_ROW x storageRows spans
+        inline LCDBuffered( LCDInterface &lcd, char *storage, dirtySpan *spanStorage, uint16_t storageSize, uint8_t storageRows,
+        uint16_t throttleTimeInMs, uint16_t updateDurationInMs ) {
+            this->lcd = &lcd;
+            mustDeletedLCD = false;
+            staticStorage     = storage;
+            staticSpans       = spanStorage;
+            staticStorageSize = storageSize;
+            staticStorageRows = storageRows;
+            initBuffers();
+            setUpdateThrottleInMs( throttleTimeInMs );
+            this->updateDurationInMs = updateDurationInMs;
+        }
+
+    public:
+
         inline void setTimeoutInMs( uint16_t timeOut ) override {
             lcd->setTimeoutInMs( timeOut );
         }
@@ -185,53 +244,280 @@ class LCDBuffered : public LCDInterface {
     public:
 
         inline void begin( uint8_t maxColumns, uint8_t maxRows, LCDInterface::charDotSize dotSize = LCDInterface::charDotSize::size5x8 ) override {
+            // buffers are reallocated, not while refresh task is using them
+            if ( refreshTaskRunning ) return;
             lcd->begin( maxColumns, maxRows, dotSize );
             initBuffers();
         }
 
+    //
+    // CANVAS / VIEWPORT
+    //
+    public:
+
+        //  Canvas larger than the LCD, only the viewport is shown
+        //  - maxColumns/maxRows become canvas size, all user operations use canvas coordinates
+        //  - screenColumns/screenRows is the LCD size
+        //  - panning only changes what is compared to the screen, nothing is re-rendered
+        //
+        //      lcd.setCanvasSize( 40, 16 );      // clears buffers
+        //      ... print menu once ...
+        //      lcd.setViewport( 0, row );       // scroll
+        //      lcd.refreshPartial();
+        //
+        //  - fails if larger than LCDBufferedStatic storage or out of memory
+        //    then nothing changes, display keeps working with previous canvas
+        //  - viewport and priority regions are clipped to the new canvas
+
+        uint8_t screenColumns = 0, screenRows = 0;
+
+        bool setCanvasSize( uint8_t columns, uint8_t rows ) {
+            // 0 to follow LCD size, smaller than LCD is not allowed
+            // buffers are reallocated, not while refresh task is using them
+            if ( refreshTaskRunning ) return false;
+            uint8_t oldColumns = canvasColumns, oldRows = canvasRows;
+            canvasColumns = columns;
+            canvasRows = rows;
+            if ( initBuffers( true ) ) return true;
+            canvasColumns = oldColumns;
+            canvasRows = oldRows;
+            return false;
+        }
+
+        void setViewport( uint8_t col, uint8_t row ) {
+            // top left of canvas shown on LCD, applied at start of next screen update
+            if ( col > maxColumns - screenColumns ) col = maxColumns - screenColumns;
+            if ( row > maxRows - screenRows ) row = maxRows - screenRows;
+            requestedView.store( ( (uint16_t) col << 8 ) | row );
+        }
+        inline uint8_t getViewportColumn() { return requestedView.load() >> 8; }
+        inline uint8_t getViewportRow()    { return requestedView.load() & 0xFF; }
+
+    private:
+
+        uint8_t canvasColumns = 0, canvasRows = 0;
+
+        // user side requests, screen update applies
+        spAtomic<uint16_t> requestedView { 0 };
+        uint8_t viewX = 0, viewY = 0;
+
+        void applyViewport() {
+            uint16_t v = requestedView.load();
+            uint8_t x = v >> 8, y = v & 0xFF;
+            if ( x == viewX && y == viewY ) return;
+            viewX = x; viewY = y;
+            // everything shown might differ, one full compare
+            for( uint8_t i = 0 ; i < screenRows ; i++ )
+                btsDirty[ viewY + i ].mark( viewX, viewX + screenColumns );
+        }
+
     //
     // BUFFERS
     //
     protected:
     
-        uint16_t bufferSize = 0;
+        uint16_t bufferSize = 0;   // canvas
+        uint16_t screenSize = 0;   // LCD
 
         // actual storage
-        char *userBuffer    = nullptr; // user updates
-        char *btsBufferCore = nullptr; // double buffer area
+        // - single buffer mode uses only bufferCore[ userIndex ]
+        // - double buffer mode rotates all 3 (triple buffering)
+        // - each buffer is followed by CGRAM_SIZE bytes of custom character bitmaps
+        //   so glyphs travel with the frame that uses them
+        // - then maxRows bytes of row map, row to storage row
+        //   vertical scroll only rotates the map, see rowOf()
+        static const uint8_t CGRAM_SIZE = 64;
+        char *bufferCore[3] = { nullptr, nullptr, nullptr };
         char *screenData    = nullptr; // text already sent to LCD
 
+        char *userBuffer = nullptr; // user updates, bufferCore[ userIndex ]
+
         // (buffer to send) points to:
-        // - userBuffer    (single buffer mode)
-        // - btsBufferCore (double buffer mode)
+        // - userBuffer            (single buffer mode)
+        // - bufferCore[btsIndex]  (double buffer mode)
         char *btsBuffer = nullptr;        
 
         enum bufferModes {
             singleBuffer, doubleBuffer
         };
         bufferModes bufferMode = doubleBuffer;
+
+        // changed columns of each row: [start,end)
+        // - userDirty: marked by user updates, eg. write(), clear(), scroll...()
+        // - btsDirty:  taken from userDirty at start of each screen update
+        struct dirtySpan {
+            uint8_t start, end;
+            inline bool isClean() { return start >= end; }
+            inline void setClean() { start = 0xFF; end = 0; }
+            inline void mark( uint8_t colFrom, uint8_t colTo ) {
+                if ( colFrom < start ) start = colFrom;
+                if ( colTo   > end   ) end   = colTo;
+            }
+        };
+        static const uint8_t SPANS_PER_ROW = 9;
+        dirtySpan *dirtySpans = nullptr; // storage for all below and frame handoff
+        dirtySpan *userDirty  = nullptr;
+        dirtySpan *btsDirty   = nullptr;
+
+        // mark columns [colFrom,colTo) of rows [rowFrom,rowTo) as changed
+        void markDirty( uint8_t colFrom, uint8_t rowFrom, uint8_t colTo, uint8_t rowTo ) {
+            for( uint8_t i = rowFrom ; i < rowTo ; i++ )
+                userDirty[i].mark( colFrom, colTo );
+        }
+        inline void markAllDirty() {
+            markDirty( 0, 0, maxColumns, maxRows );
+        }
+
+        inline void mergeSpans( dirtySpan *to, dirtySpan *from ) {
+            for( uint8_t i = 0 ; i < maxRows ; i++ )
+                if ( !from[i].isClean() ) to[i].mark( from[i].start, from[i].end );
+        }
+        inline void copySpans( dirtySpan *to, dirtySpan *from ) {
+            memcpy( to, from, maxRows * sizeof( dirtySpan ) );
+        }
+        inline void cleanSpans( dirtySpan *spans ) {
+            for( uint8_t i = 0 ; i < maxRows ; i++ )
+                spans[i].setClean();
+        }
+
+        inline uint16_t bufferCoreSize() {
+            return bufferSize + CGRAM_SIZE + maxRows;
+        }
+        inline uint8_t *rowMapOf( char *buffer ) {
+            return (uint8_t *) buffer + bufferSize + CGRAM_SIZE;
+        }
+        inline char *rowOf( char *buffer, uint8_t row ) {
+            return buffer + rowMapOf( buffer )[row] * maxColumns;
+        }
+
+        // fixed storage, not allocated/freed
+        char *staticStorage = nullptr;
+        dirtySpan *staticSpans = nullptr;
+        uint16_t staticStorageSize = 0;
+        uint8_t staticStorageRows = 0;
+
+        bool allocateBuffers() {
+            if ( staticStorage != nullptr ) {
+                // screen must fit
+                if ( bufferSize > staticStorageSize || maxRows > staticStorageRows ) return false;
+                for( uint8_t i = 0 ; i < 3 ; i++ )
+                    bufferCore[i] = staticStorage + i * bufferCoreSize();
+                screenData = staticStorage + 3 * bufferCoreSize();
+                dirtySpans = staticSpans;
+                return true;
+            }
+            // new buffers first, previous ones kept if out of memory
+            char *core[3];
+            for( uint8_t i = 0 ; i < 3 ; i++ )
+                core[i] = new char[ bufferCoreSize() ];
+            char *screen = new char[ screenSize ];
+            dirtySpan *spans = new dirtySpan[ maxRows * SPANS_PER_ROW ];
+            if ( core[0] == nullptr || core[1] == nullptr || core[2] == nullptr || screen == nullptr || spans == nullptr ) {
+                for( uint8_t i = 0 ; i < 3 ; i++ )
+                    if ( core[i] != nullptr ) delete[] core[i];
+                if ( screen != nullptr ) delete[] screen;
+                if ( spans != nullptr ) delete[] spans;
+                return false;
+            }
+            freeBuffers();
+            for( uint8_t i = 0 ; i < 3 ; i++ )
+                bufferCore[i] = core[i];
+            screenData = screen;
+            dirtySpans = spans;
+            return true;
+        }
+
+        void freeBuffers() {
+            if ( staticStorage != nullptr ) return;
+            for( uint8_t i = 0 ; i < 3 ; i++ ) {
+                if ( bufferCore[i] != nullptr ) delete[] bufferCore[i];
+                bufferCore[i] = nullptr;
+            }
+            if ( screenData != nullptr ) delete[] screenData;
+            if ( dirtySpans != nullptr ) delete[] dirtySpans;
+            screenData = nullptr;
+            dirtySpans = nullptr;
+        }
         
-        void initBuffers() {
+        bool initBuffers( bool keepOnFailure = false ) {
 
             // not initialized
-            if ( lcd == nullptr ) return;
-            if ( lcd->maxColumns == 0 || lcd->maxRows == 0 ) return;
+            if ( lcd == nullptr ) return false;
+            if ( lcd->maxColumns == 0 || lcd->maxRows == 0 ) return false;
+
+            // previous layout, restored if new one does not fit and keepOnFailure
+            uint8_t  oldScreenColumns = screenColumns, oldScreenRows = screenRows;
+            uint8_t  oldColumns = maxColumns, oldRows = maxRows;
+            uint16_t oldBufferSize = bufferSize, oldScreenSize = screenSize;
 
-            this->maxColumns = lcd->maxColumns;
-            this->maxRows = lcd->maxRows;
+            screenColumns = lcd->maxColumns;
+            screenRows = lcd->maxRows;
+            this->maxColumns = ( canvasColumns > screenColumns ) ? canvasColumns : screenColumns;
+            this->maxRows    = ( canvasRows    > screenRows    ) ? canvasRows    : screenRows;
 
             bufferSize = maxColumns * maxRows;
-            if ( userBuffer    != nullptr ) delete userBuffer;
-            if ( btsBufferCore != nullptr ) delete btsBufferCore;
-            if ( screenData    != nullptr ) delete screenData;
-            userBuffer    = new char[ bufferSize ];
-            screenData    = new char[ bufferSize ];
-            btsBufferCore = new char[ bufferSize ];
+            screenSize = screenColumns * screenRows;
+            if ( !allocateBuffers() ) {
+                if ( keepOnFailure && oldBufferSize != 0 ) {
+                    // buffers were not touched
+                    screenColumns = oldScreenColumns; screenRows = oldScreenRows;
+                    this->maxColumns = oldColumns; this->maxRows = oldRows;
+                    bufferSize = oldBufferSize; screenSize = oldScreenSize;
+                    return false;
+                }
+                // does not fit in fixed storage or out of memory
+                // leave uninitialized, writes will be offscreen
+                // drop pointers into storage laid out for previous size
+                bufferSize = 0;
+                screenSize = 0;
+                this->maxColumns = 0;
+                this->maxRows = 0;
+                for( uint8_t i = 0 ; i < 3 ; i++ ) {
+                    bufferCore[i] = nullptr;
+                    frameDirty[i] = nullptr;
+                    staleDirty[i] = nullptr;
+                }
+                screenData = nullptr;
+                userBuffer = nullptr;
+                btsBuffer  = nullptr;
+                dirtySpans = nullptr;
+                userDirty  = nullptr;
+                btsDirty   = nullptr;
+                pendingDirty = nullptr;
+                offscreen  = true;
+                return false;
+            }
+            userDirty    = dirtySpans;
+            btsDirty     = dirtySpans + maxRows;
+            pendingDirty = dirtySpans + maxRows * 2;
+            for( uint8_t i = 0 ; i < 3 ; i++ ) {
+                frameDirty[i] = dirtySpans + maxRows * ( 3 + i );
+                staleDirty[i] = dirtySpans + maxRows * ( 6 + i );
+            }
 
+            userIndex = 0;
+            userBuffer = bufferCore[ userIndex ];
             memset( userBuffer, ' ', bufferSize );
-            memset( screenData, ' ', bufferSize );
-
-            btsBuffer = btsBufferCore;
+            memset( userBuffer + bufferSize, 0, CGRAM_SIZE );
+            for( uint8_t i = 0 ; i < maxRows ; i++ )
+                rowMapOf( userBuffer )[i] = i;
+            memset( screenData, ' ', screenSize );
+            userGlyphDefined = 0; userGlyphDirty = 0;
+            btsGlyphDirty = 0; screenGlyphValid = 0;
+            // keep viewport inside new canvas, both sides blank so nothing to compare
+            uint16_t v = requestedView.load();
+            viewX = v >> 8; viewY = v & 0xFF;
+            if ( viewX > maxColumns - screenColumns ) viewX = maxColumns - screenColumns;
+            if ( viewY > maxRows - screenRows ) viewY = maxRows - screenRows;
+            requestedView.store( ( (uint16_t) viewX << 8 ) | viewY );
+
+            // both blank, nothing to send
+            cleanSpans( userDirty );
+            cleanSpans( btsDirty );
+            vCursorLastPos = NO_POS;
+            clipPriorityRegions();
+
+            btsBuffer = userBuffer;
             
             // fake to single, so can switch to double            
             bufferMode = singleBuffer;
@@ -240,6 +526,7 @@ class LCDBuffered : public LCDInterface {
             // if not properly initialized, will go offScreen
             // eg. lcd.begin not called, so maxColumns = maxRows = 0
             setCursor( 0, 0 );
+            return true;
         }
 
     public:
@@ -255,39 +542,141 @@ class LCDBuffered : public LCDInterface {
         //       current compare position at x=6
         //       so "world" will get sent first, then possibly trottled
         //
-        // Double Buffer
-        // - userBuffer copied to btsBuffer
-        // - btsBuffer compared to screenData
-        // - if using multicore, can use pauseUpdate()/resumeUpdate()
-        //   so copying userBuffer to btsBuffer will get paused
-        //   on resume will start updating from position 0
+        // Double Buffer (actually triple)
+        // - finished user updates are published by swapping buffer index, no copying
+        //   user           --> userBuffer
+        //   publishFrame() --> userBuffer <-> readyBuffer (index swap)
+        //   pickup         --> readyBuffer <-> btsBuffer  (index swap)
+        //   btsBuffer compared to screenData
+        // - new userBuffer only copies changed spans it missed
+        // - if using multicore, use pauseUpdate()/resumeUpdate()
+        //   frame is published on resumeUpdate(),
+        //   otherwise published at start of each screen update
 
         void useSingleBuffer() {
             // userBuffer --> (compared) --> screenData
-            if ( bufferMode == singleBuffer ) return;
+            if ( bufferMode == singleBuffer || bufferSize == 0 ) return;
+            // refresh task requires double buffer
+            if ( refreshTaskRunning ) return;
             // point btsBuffer to userBuffer
             btsBuffer  = userBuffer;
             bufferMode = singleBuffer;
+            markAllDirty();
+            userGlyphDirty = userGlyphDefined;
             btsMode = mStart;
             btsLastCompletedUpdate = millis() - btsThrottleInMs;
         }
 
         void useDoubleBuffer() {
-            // userBuffer --> (copied) --> btsBufferCore --> (compared) --> screenData
-            if ( bufferMode == doubleBuffer ) return;
-            // point btsBuffer to btsBufferCore
-            // copy first current userBuffer, best effort to lock
-            // xSemaphoreTake( userBufferSem, semLockTimeout );
-            userBufferSem.take( SEM_ID_copyUserBuffer );
-            memcpy( btsBufferCore, userBuffer, bufferSize );
-            userBufferSem.release( SEM_ID_copyUserBuffer );
-            // xSemaphoreGive( userBufferSem );
-            btsBuffer  = btsBufferCore;
+            // userBuffer --> (published) --> sharedFrame --> (picked up) --> btsBuffer --> (compared) --> screenData
+            if ( bufferMode == doubleBuffer || bufferSize == 0 ) return;
+            // start all buffers the same, one time copy
+            // not thread safe, switch before updating from another core/task
+            char *current = userBuffer;
+            initHandoff();
+            for( uint8_t i = 0 ; i < 3 ; i++ )
+                if ( bufferCore[i] != current ) memcpy( bufferCore[i], current, bufferCoreSize() );
+            userBuffer = bufferCore[ userIndex ];
+            if ( userBuffer != current ) memcpy( userBuffer, current, bufferCoreSize() );
+            btsBuffer  = bufferCore[ btsIndex ];
             bufferMode = doubleBuffer;
+            markAllDirty();
+            userGlyphDirty = userGlyphDefined;
             btsMode = mStart;
             btsLastCompletedUpdate = millis() - btsThrottleInMs;
         }
 
+    //
+    // FRAME HANDOFF
+    //
+    private:
+
+        // buffer roles, swapped instead of copying contents
+        // - userIndex   : owned by user updates
+        // - sharedFrame : last published frame, exchanged atomically (lock free)
+        // - btsIndex    : owned by screen update, read only
+        uint8_t userIndex = 0, btsIndex = 2;
+        static const uint8_t FRESH_FRAME = 0x80;    // sharedFrame not yet picked up
+        spAtomic<uint8_t> sharedFrame { 1 };
+
+        // generation of published frames
+        // so user side knows which changes screen update already has
+        uint32_t publishedGeneration = 0;           // user side
+        uint32_t frameGeneration[3] = { 0, 0, 0 };  // generation of frame in each buffer
+        spAtomic<uint32_t> pickedGeneration { 0 };  // last picked up by screen update
+
+        dirtySpan *pendingDirty  = nullptr;                        // user side: changes not yet picked up
+        dirtySpan *frameDirty[3] = { nullptr, nullptr, nullptr };  // changes carried by each published frame
+        dirtySpan *staleDirty[3] = { nullptr, nullptr, nullptr };  // user side: changes each buffer missed
+
+        // same for custom characters, 1 bit per CGRAM slot
+        uint8_t pendingGlyphDirty  = 0;
+        uint8_t frameGlyphDirty[3] = { 0, 0, 0 };
+
+        bool publishOnResume = false;       // set once pauseUpdate() is used
+
+        void initHandoff() {
+            userIndex = 0; btsIndex = 2;
+            sharedFrame.store( 1 );
+            publishedGeneration = 0;
+            pickedGeneration.store( 0 );
+            cleanSpans( pendingDirty );
+            pendingGlyphDirty = 0;
+            for( uint8_t i = 0 ; i < 3 ; i++ ) {
+                frameGeneration[i] = 0;
+                frameGlyphDirty[i] = 0;
+                cleanSpans( frameDirty[i] );
+                cleanSpans( staleDirty[i] );
+            }
+        }
+
+        void publishFrame() {
+            // user side: hand over userBuffer as latest frame, O(rows)
+            // if previous frame was not picked up, its changes are carried over
+            if ( bufferSize == 0 ) return;
+            if ( pickedGeneration.load() == publishedGeneration ) {
+                cleanSpans( pendingDirty );
+                pendingGlyphDirty = 0;
+            }
+            mergeSpans( pendingDirty, userDirty );
+            copySpans( frameDirty[ userIndex ], pendingDirty );
+            pendingGlyphDirty |= userGlyphDirty;
+            frameGlyphDirty[ userIndex ] = pendingGlyphDirty;
+            frameGeneration[ userIndex ] = ++publishedGeneration;
+            for( uint8_t i = 0 ; i < 3 ; i++ )
+                if ( i != userIndex ) mergeSpans( staleDirty[i], userDirty );
+            uint8_t published = userIndex;
+            userIndex = sharedFrame.exchange( published | FRESH_FRAME ) & ~FRESH_FRAME;
+
+            // new userBuffer is owned only by user side, bring it up to date
+            // published buffer will not be written by screen update
+            char *from = bufferCore[ published ];
+            userBuffer = bufferCore[ userIndex ];
+            // all bitmaps and row map, cheaper than tracking which ones
+            // rows moved by scrolling are always marked whole, so copied below
+            memcpy( userBuffer + bufferSize, from + bufferSize, CGRAM_SIZE + maxRows );
+            dirtySpan *stale = staleDirty[ userIndex ];
+            for( uint8_t i = 0 ; i < maxRows ; i++ ) {
+                if ( stale[i].isClean() ) continue;
+                uint8_t start = stale[i].start;
+                memcpy( rowOf( userBuffer, i ) + start, rowOf( from, i ) + start, stale[i].end - start );
+                stale[i].setClean();
+            }
+            cleanSpans( userDirty );
+            userGlyphDirty = 0;
+        }
+
+        void pickupFrame() {
+            // screen side: take latest published frame, if any
+            if ( sharedFrame.load() & FRESH_FRAME ) {
+                btsIndex = sharedFrame.exchange( btsIndex ) & ~FRESH_FRAME;
+                mergeSpans( btsDirty, frameDirty[ btsIndex ] );
+                btsGlyphDirty |= frameGlyphDirty[ btsIndex ];
+                pickedGeneration.store( frameGeneration[ btsIndex ] );
+            }
+            btsBuffer = bufferCore[ btsIndex ];
+        }
+
     //
     // VERIFY / RECOVERY
     //
@@ -301,20 +690,47 @@ class LCDBuffered : public LCDInterface {
         }
         
         bool recoverIfHasError() override {
-            bool r = lcd->recoverIfHasError();
-            if ( r ) reset();
-            return r;
+            // refresh task owns the bus, it recovers by itself
+            if ( refreshTaskRunning ) return false;
+            return recoverCore();
         }
         inline void setRecoveryThrottleInMs( uint16_t delay ) override {
             lcd->setRecoveryThrottleInMs( delay );
         }
         void reset() override {
-            // if LCD is reset, will revert to blanks
-            memset( screenData, ' ', bufferSize );
+            // refresh task owns screenData, let it do the reset
+            if ( refreshTaskRunning ) {
+                resetRequested.store( true );
+                return;
+            }
+            resetCore();
             // updateAllNow();
             refresh();
         }
 
+    private:
+
+        spAtomic<bool> resetRequested { false };     // from user side, done by refresh task
+
+        bool recoverCore() {
+            bool r = lcd->recoverIfHasError();
+            if ( r ) {
+                resetCore();
+                refreshCore();
+            }
+            return r;
+        }
+        void resetCore() {
+            // if LCD is reset, will revert to blanks
+            memset( screenData, ' ', screenSize );
+            // resend frame being updated, not waiting for user to publish
+            for( uint8_t i = 0 ; i < maxRows ; i++ )
+                btsDirty[i].mark( 0, maxColumns );
+            // CGRAM may be lost too, resend glyphs already uploaded
+            btsGlyphDirty |= screenGlyphValid;
+            screenGlyphValid = 0;
+        }
+
     //
     // USER'S UPDATES
     //
@@ -322,12 +738,6 @@ class LCDBuffered : public LCDInterface {
         
         uint8_t userCursorX = 0, userCursorY = 0;
         bool offscreen = true;
-        // SemaphoreHandle_t userBufferSem = xSemaphoreCreateMutex();
-        // TickType_t semLockTimeout = portTICK_PERIOD_MS * 50;
-        spSemaphore userBufferSem = spSemaphore( 50 );
-
-        const uint8_t SEM_ID_pauseResume = 10;
-        const uint8_t SEM_ID_copyUserBuffer = 20;
 
     public:
 
@@ -352,26 +762,25 @@ class LCDBuffered : public LCDInterface {
         //      }
 
         void setSemaphoreLockTimeoutInMs( uint16_t waitingTime ) {
-            // semLockTimeout = portTICK_PERIOD_MS * waitingTime;
-            userBufferSem.timeoutInMs = waitingTime;
+            // frame handoff is lock free, kept for compatibility
+            (void) waitingTime;
         }
 
         bool pauseUpdate() {
             // pause succeeding operations (eg. print, write ) from propagating to screen
             // previous pending updates will proceed
-            if ( bufferMode == doubleBuffer ) {
-                // xSemaphoreTake( userBufferSem, portMAX_DELAY );
-                // return ( xSemaphoreTake( userBufferSem, semLockTimeout ) == pdTRUE );
-                return userBufferSem.take( SEM_ID_pauseResume );
-            }
+            // no locking, updates just stay in userBuffer until published
+            // once used, frames are published only by resumeUpdate()
+            // so screen update never swaps userBuffer while user is writing
+            if ( bufferMode == doubleBuffer && !publishOnResume )
+                publishOnResume = true;
             return true;
         }
 
         void resumeUpdate() {
-            // resume updating
+            // resume updating, publish everything since pauseUpdate() as one frame
             if ( bufferMode == doubleBuffer )
-                // xSemaphoreGive( userBufferSem );
-                userBufferSem.release( SEM_ID_pauseResume );
+                publishFrame();
         }
 
     //
@@ -385,16 +794,36 @@ class LCDBuffered : public LCDInterface {
     
         size_t write( uint8_t ch ) override {
             if ( offscreen ) return 0;
-            uint16_t pos = userCursorY * maxColumns + userCursorX;
-            if ( pos > bufferSize ) pos = pos % bufferSize;
-            userBuffer[pos] = ch;
+            rowOf( userBuffer, userCursorY )[userCursorX] = ch;
+            userDirty[userCursorY].mark( userCursorX, userCursorX+1 );
             if ( cursorMovementLeftToRight )
                 cursorForward();
             else
                 cursorBackward();
             return 1;
         }
-        
+
+        size_t write( const uint8_t *buffer, size_t size ) override {
+            // print(), printf()... copy part that fits in current row at once
+            // cursor wrap is resolved once per row instead of per character
+            if ( !cursorMovementLeftToRight )
+                return LCDInterface::write( buffer, size );
+            size_t written = 0;
+            while( written < size && !offscreen ) {
+                uint8_t room = maxColumns - userCursorX;
+                uint8_t n = ( size - written < room ) ? size - written : room;
+                memcpy( rowOf( userBuffer, userCursorY ) + userCursorX, buffer + written, n );
+                userDirty[userCursorY].mark( userCursorX, userCursorX + n );
+                written += n;
+                // last character moves cursor, same as write( ch )
+                userCursorX += n - 1;
+                cursorForward();
+            }
+            return written;
+        }
+
+        using LCDInterface::write;
+
         bool cursorAutoCarriageReturn = false; // move to next line after end of current line
         bool cursorAutoJumpToStart    = false; // move to (0,0) after end of screen
 
@@ -452,7 +881,9 @@ class LCDBuffered : public LCDInterface {
     public:
 
         void clear() override {
+            if ( bufferSize == 0 ) return;
             memset( userBuffer, ' ', bufferSize );
+            markAllDirty();
             setCursor( 0, 0 );
         }
 
@@ -467,10 +898,23 @@ class LCDBuffered : public LCDInterface {
             offscreen = ( userCursorX >= maxColumns || userCursorY >= maxRows );
         }
 
-        inline void backlightOn()  override { lcd->backlightOn();  }
-        inline void backlightOff() override { lcd->backlightOff(); }
-        inline void displayOn()    override { lcd->displayOn();    }
-        inline void displayOff()   override { lcd->displayOff();   }
+        // refresh task owns the bus, let it send these
+        void backlightOn() override {
+            if ( refreshTaskRunning ) requestedBacklight.store( stateOn );
+            else lcd->backlightOn();
+        }
+        void backlightOff() override {
+            if ( refreshTaskRunning ) requestedBacklight.store( stateOff );
+            else lcd->backlightOff();
+        }
+        void displayOn() override {
+            if ( refreshTaskRunning ) requestedDisplay.store( stateOn );
+            else lcd->displayOn();
+        }
+        void displayOff() override {
+            if ( refreshTaskRunning ) requestedDisplay.store( stateOff );
+            else lcd->displayOff();
+        }
 
         inline void moveCursorRight() override { cursorForward(); }
         inline void moveCursorLeft()  override { cursorBackward(); }
@@ -478,26 +922,22 @@ class LCDBuffered : public LCDInterface {
         void scrollDisplayLeft() override {
             // ABCDE
             // BCDE_
-            char *from = userBuffer+1;
-            char *to   = userBuffer;
             for( uint8_t i = 0 ; i < maxRows ; i++ ) {
-                memmove( to, from, maxColumns-1 );
-                userBuffer[(i+1)*maxColumns-1] = ' ';
-                from += maxColumns;
-                to += maxColumns;
+                char *row = rowOf( userBuffer, i );
+                memmove( row, row+1, maxColumns-1 );
+                row[maxColumns-1] = ' ';
             }
+            markAllDirty();
         }
         void scrollDisplayRight() override {
             // ABCDE
             // _ABCD
-            char *from = userBuffer;
-            char *to   = userBuffer+1;
             for( uint8_t i = 0 ; i < maxRows ; i++ ) {
-                memmove( to, from, maxColumns-1 );
-                userBuffer[i*maxColumns] = ' ';
-                from += maxColumns;
-                to += maxColumns;
+                char *row = rowOf( userBuffer, i );
+                memmove( row+1, row, maxColumns-1 );
+                row[0] = ' ';
             }
+            markAllDirty();
         }
 
         inline void leftToRight() override { cursorMovementLeftToRight = true;  }
@@ -506,10 +946,31 @@ class LCDBuffered : public LCDInterface {
         inline void autoscrollOn () override {} // not supported
         inline void autoscrollOff() override {}
 
-        inline void createChar( uint8_t charID, const uint8_t charmap[] ) override { lcd->createChar( charID, charmap ); }
-        inline void createChar( uint8_t charID, const char *charmap )     override { lcd->createChar( charID, charmap ); }
+        void createChar( uint8_t charID, const uint8_t charmap[] ) override {
+            // keep bitmap with frame, uploaded during screen updates
+            if ( bufferSize == 0 ) {
+                // not yet initialized, send directly
+                // refresh task cannot be running without buffers
+                lcd->createChar( charID, charmap );
+                return;
+            }
+            charID &= 0x07;
+            uint8_t mask = 1 << charID;
+            char *glyph = userBuffer + bufferSize + charID * 8;
+            if ( ( userGlyphDefined & mask ) && memcmp( glyph, charmap, 8 ) == 0 ) return;
+            memcpy( glyph, charmap, 8 );
+            userGlyphDefined |= mask;
+            userGlyphDirty |= mask;
+        }
+        inline void createChar( uint8_t charID, const char *charmap ) override {
+            createChar( charID, (const uint8_t *) charmap );
+        }
 
-        inline void command( uint8_t value ) override { lcd->command( value ); }
+        inline void command( uint8_t value ) override {
+            // ignored while refresh task owns the bus
+            if ( refreshTaskRunning ) return;
+            lcd->command( value );
+        }
 
     //
     // ADDITIONAL FUNCTIONALITIES
@@ -517,22 +978,49 @@ class LCDBuffered : public LCDInterface {
     public:
 
         void scrollDisplayUp( bool clearLastRow = true ) {
-            for( uint8_t i = 0 ; i+1 < maxRows ; i++ )
-                memcpy( userBuffer + i*maxColumns, userBuffer + (i+1)*maxColumns, maxColumns );
-            if ( clearLastRow )
-                memset( userBuffer + (maxRows-1)*maxColumns, ' ', maxColumns );
+            if ( maxRows == 0 ) return;
+            rotateRowsUp( 0, maxRows-1, clearLastRow );
+            markAllDirty();
         }
 
         void scrollDisplayDown( bool clearTopRow = true ) {
-            for( int i = maxRows-1 ; i >= 1 ; i-- )
-                memcpy( userBuffer + i*maxColumns, userBuffer + (i-1)*maxColumns, maxColumns );
+            if ( maxRows == 0 ) return;
+            rotateRowsDown( 0, maxRows-1, clearTopRow );
+            markAllDirty();
+        }
+
+    private:
+
+        // full width rows, only row map is changed
+        // not cleared row keeps its contents, same as copying rows
+
+        void rotateRowsUp( uint8_t row1, uint8_t row2, bool clearLastRow ) {
+            uint8_t *map = rowMapOf( userBuffer );
+            uint8_t first = map[row1];
+            memmove( map + row1, map + row1 + 1, row2 - row1 );
+            map[row2] = first;
+            if ( clearLastRow )
+                memset( rowOf( userBuffer, row2 ), ' ', maxColumns );
+            else if ( row2 > row1 )
+                memcpy( rowOf( userBuffer, row2 ), rowOf( userBuffer, row2-1 ), maxColumns );
+        }
+
+        void rotateRowsDown( uint8_t row1, uint8_t row2, bool clearTopRow ) {
+            uint8_t *map = rowMapOf( userBuffer );
+            uint8_t last = map[row2];
+            memmove( map + row1 + 1, map + row1, row2 - row1 );
+            map[row1] = last;
             if ( clearTopRow )
-                memset( userBuffer, ' ', maxColumns );
+                memset( rowOf( userBuffer, row1 ), ' ', maxColumns );
+            else if ( row2 > row1 )
+                memcpy( rowOf( userBuffer, row1 ), rowOf( userBuffer, row1+1 ), maxColumns );
         }
 
+    public:
+
         inline bool checkToBounds( uint8_t &col1, uint8_t &row1, uint8_t &col2, uint8_t &row2 ) {
             if ( col1 > col2 ) { auto t=col1; col1=col2; col2=t; }
-            if ( row1 > col2 ) { auto t=row1; row1=col2; col2=t; }
+            if ( row1 > row2 ) { auto t=row1; row1=row2; row2=t; }
             // CASE (1) - adjust to bounds
             // if ( col1 < 0 ) col1 = 0;
             // if ( row1 < 0 ) row1 = 0;
@@ -547,67 +1035,55 @@ class LCDBuffered : public LCDInterface {
         void scrollWindowLeft( uint8_t col1, uint8_t row1, uint8_t col2, uint8_t row2 ) {
             if ( !checkToBounds( col1, row1, col2, row2 ) ) return;
 
-            char *from = userBuffer + row1*maxColumns+col1+1;
-            char *to   = userBuffer + row1*maxColumns+col1;
             uint8_t count = col2 - col1;
-            char *spaceChar = userBuffer + row1*maxColumns+col2;
-
             for( uint8_t i = row1 ; i <= row2 ; i++ ) {
-                memmove( to, from, count );
-                from += maxColumns;
-                to += maxColumns;
-                *spaceChar = ' ';
-                spaceChar += maxColumns;
+                char *row = rowOf( userBuffer, i );
+                memmove( row+col1, row+col1+1, count );
+                row[col2] = ' ';
             }
+            markDirty( col1, row1, col2+1, row2+1 );
         }
 
         void scrollWindowRight( uint8_t col1, uint8_t row1, uint8_t col2, uint8_t row2 ) {
             if ( !checkToBounds( col1, row1, col2, row2 ) ) return;
 
-            char *from = userBuffer + row1*maxColumns+col1;
-            char *to   = userBuffer + row1*maxColumns+col1+1;
             uint8_t count = col2 - col1;
-            char *spaceChar = userBuffer + row1*maxColumns+col1;
-            
             for( uint8_t i = row1 ; i <= row2 ; i++ ) {
-                memmove( to, from, count );
-                from += maxColumns;
-                to += maxColumns;
-                *spaceChar = ' ';
-                spaceChar += maxColumns;
+                char *row = rowOf( userBuffer, i );
+                memmove( row+col1+1, row+col1, count );
+                row[col1] = ' ';
             }
+            markDirty( col1, row1, col2+1, row2+1 );
         }
 
         void scrollWindowUp( uint8_t col1, uint8_t row1, uint8_t col2, uint8_t row2, bool clearLastRow = true ) {
             if ( !checkToBounds( col1, row1, col2, row2 ) ) return;
 
-            char *from = userBuffer + (row1+1)*maxColumns+col1;
-            char *to   = userBuffer + row1*maxColumns+col1;
             uint8_t count = col2 - col1 + 1;
-
-            for( uint8_t i = row1 ; i+1 <= row2 ; i++ ) {
-                memcpy( to, from, count );
-                from += maxColumns;
-                to += maxColumns;
+            if ( count == maxColumns ) {
+                rotateRowsUp( row1, row2, clearLastRow );
+            } else {
+                for( uint8_t i = row1 ; i+1 <= row2 ; i++ )
+                    memcpy( rowOf( userBuffer, i ) + col1, rowOf( userBuffer, i+1 ) + col1, count );
+                if ( clearLastRow )
+                    memset( rowOf( userBuffer, row2 ) + col1, ' ', count );
             }
-            if ( clearLastRow )
-                memset( to, ' ', count );
+            markDirty( col1, row1, col2+1, row2+1 );
         }
 
         void scrollWindowDown( uint8_t col1, uint8_t row1, uint8_t col2, uint8_t row2, bool clearLastRow = true ) {
             if ( !checkToBounds( col1, row1, col2, row2 ) ) return;
 
-            char *from = userBuffer + (row2-1)*maxColumns+col1;
-            char *to   = userBuffer + row2*maxColumns+col1;
             uint8_t count = col2 - col1 + 1;
-
-            for( uint8_t i = row2 ; i > row1 ; i-- ) {
-                memcpy( to, from, count );
-                from -= maxColumns;
-                to -= maxColumns;
+            if ( count == maxColumns ) {
+                rotateRowsDown( row1, row2, clearLastRow );
+            } else {
+                for( uint8_t i = row2 ; i > row1 ; i-- )
+                    memcpy( rowOf( userBuffer, i ) + col1, rowOf( userBuffer, i-1 ) + col1, count );
+                if ( clearLastRow )
+                    memset( rowOf( userBuffer, row1 ) + col1, ' ', count );
             }
-            if ( clearLastRow )
-                memset( to, ' ', count );
+            markDirty( col1, row1, col2+1, row2+1 );
         }
 
         void clearToEOL() {
@@ -635,6 +1111,11 @@ class LCDBuffered : public LCDInterface {
         bool cursorIsDisplayed = false;
         uint32_t cursorLastBlinkUpdate;
 
+        // position of virtual cursor on last screen update
+        // must be restored if cursor moved or turned off
+        static const uint16_t NO_POS = 0xFFFF;
+        uint16_t vCursorLastPos = NO_POS;
+
         // inline virtualCursorOption vcTurnOn( virtualCursorOption value, virtualCursorOption bitToChange ) {
         //     return static_cast<virtualCursorOption>( static_cast<int>(value) | static_cast<int>(bitToChange) ); }
         // inline virtualCursorOption vcTurnOff( virtualCursorOption value, virtualCursorOption bitToChange ) {
@@ -680,6 +1161,22 @@ class LCDBuffered : public LCDInterface {
 
     private:
 
+        void markVirtualCursorDirty() {
+            // virtual cursor is not part of user updates,
+            // so include previous and current location on every screen update
+            if ( vCursorLastPos != NO_POS ) {
+                uint8_t col = vCursorLastPos % maxColumns;
+                btsDirty[vCursorLastPos / maxColumns].mark( col, col+1 );
+                vCursorLastPos = NO_POS;
+            }
+            if ( !isCursorOn ) return;
+            uint16_t pos = vCursorY * maxColumns + vCursorX;
+            if ( pos >= bufferSize ) pos = pos % bufferSize;
+            uint8_t col = pos % maxColumns;
+            btsDirty[pos / maxColumns].mark( col, col+1 );
+            vCursorLastPos = pos;
+        }
+
         void toggleBlinkingCursor() {
             uint16_t duration = cursorIsDisplayed ? cursorBlinkOnDurationInMs : cursorBlinkOffDurationInMs;
             uint32_t now = millis();
@@ -690,38 +1187,7 @@ class LCDBuffered : public LCDInterface {
             // if ( !cursorIsDisplayed ) return ch;
         }
 
-        inline void processVirtualCursor_DoubleBuffer() {
-            if ( !isCursorOn ) return;
-            // if ( !vcIsItOn( cCursorOn ) ) return;
-
-            // already checked
-            // if ( bufferMode != doubleBuffer ) return;
-            // if ( bufferSize == 0 ) return; // not yet initialized
-
-            if ( isCursorBlinking ) {
-                toggleBlinkingCursor();
-                if ( !cursorIsDisplayed ) return;
-            }
-
-            // if ( vcIsItOn( cBlinking ) ) {
-            //     uint32_t now = millis();
-            //     if ( cursorIsDisplayed ) {
-            //         if ( now - cursorLastBlinkUpdate >= cursorBlinkOnDurationInMs ) {
-            //             cursorLastBlinkUpdate = now;
-            //             cursorIsDisplayed = false;
-            //         }
-            //     } else if ( now - cursorLastBlinkUpdate >= cursorBlinkOffDurationInMs ) {
-            //         cursorLastBlinkUpdate = now;
-            //         cursorIsDisplayed = true;
-            //     }
-            //     if ( !cursorIsDisplayed ) return;
-            // }
-            uint16_t pos = vCursorY * maxColumns + vCursorX;
-            if ( pos > bufferSize ) pos = pos % bufferSize;
-            btsBuffer[pos] = virtualCursorChar;
-        }
-
-        inline char processVirtualCursor_SingleBuffer( uint8_t col, uint8_t row, char ch ) {
+        inline char processVirtualCursor( uint8_t col, uint8_t row, char ch ) {
             if ( !isCursorOn ) return ch;
             if ( col != vCursorX || row != vCursorY ) return ch;
             if ( isCursorBlinking ) {
@@ -742,7 +1208,6 @@ class LCDBuffered : public LCDInterface {
     //
     private:
 
-        uint8_t btsPtr = 0;
         uint8_t btsCursorX = 0, btsCursorY = 0;
 
         uint32_t btsLastCompletedUpdate = millis();
@@ -757,6 +1222,88 @@ class LCDBuffered : public LCDInterface {
 
         uint16_t updateDurationInMs = 10;
 
+        // adaptive time budget
+        // - cost of characters and cursor moves are measured as they are sent
+        // - each refreshPartial() stops before the next run is predicted to exceed target
+        // - at least 1 character is sent per call, so slow LCDs still progress
+        // - 0 to turn off and use updateDurationInMs instead
+        // ex. lcd.setAdaptiveUpdateInUs( 500 ); // keep loop jitter under ~0.5ms
+        uint16_t adaptiveUpdateInUs = 0;
+
+        inline void setAdaptiveUpdateInUs( uint16_t targetInUs ) {
+            adaptiveUpdateInUs = targetInUs;
+        }
+
+        struct refreshTiming {
+            uint16_t usPerChar;         // measured cost per character sent
+            uint16_t usPerCursorMove;   // measured cost per setCursor()
+            uint32_t lastSliceInUs;     // duration of last refreshPartial() that did work
+        };
+
+        refreshTiming getRefreshTiming() {
+            refreshTiming r;
+            r.usPerChar       = avgCharCost16 >> 4;
+            r.usPerCursorMove = avgMoveCost16 >> 4;
+            r.lastSliceInUs   = lastSliceInUs;
+            return r;
+        }
+
+        // counters kept by screen updates, cheap enough to leave on
+        // if refresh task is running, snapshot may be a few counts off
+        struct refreshStats {
+            uint32_t framesCompleted;       // refreshPartial() finished screen, or refresh()
+            uint32_t framesTimedOut;        // refreshPartial() ran out of time, continues next call
+            uint32_t throttled;             // refreshPartial() returned Throttling
+            uint32_t charsCompared;         // characters checked against screenData
+            uint32_t charsWritten;          // characters sent to LCD, including bridged gaps
+            uint32_t cursorMoves;           // setCursor() sent to LCD
+            uint32_t bytesSavedByBridging;  // transport cost saved by rewriting gaps instead of moving cursor
+            uint32_t maxSliceInUs;          // worst refreshPartial() duration
+            uint32_t glyphUploads;          // createChar() sent to LCD
+            uint32_t glyphUploadsSkipped;   // createChar() not sent, LCD already has same bitmap
+        };
+
+        inline refreshStats getRefreshStats() { return stats; }
+        inline void resetRefreshStats() { memset( &stats, 0, sizeof( stats ) ); }
+
+        void printRefreshStats( Print &out ) {
+            refreshStats r = stats;
+            out.print( "frames "   ); out.print( r.framesCompleted );
+            out.print( " timeout " ); out.print( r.framesTimedOut );
+            out.print( " throttle "); out.println( r.throttled );
+            out.print( "compared " ); out.print( r.charsCompared );
+            out.print( " written " ); out.print( r.charsWritten );
+            out.print( " moves "   ); out.print( r.cursorMoves );
+            out.print( " saved "   ); out.println( r.bytesSavedByBridging );
+            out.print( "max slice us " ); out.print( r.maxSliceInUs );
+            out.print( " glyphs "  ); out.print( r.glyphUploads );
+            out.print( " skipped " ); out.println( r.glyphUploadsSkipped );
+        }
+
+    private:
+
+        refreshStats stats = {};
+
+        // moving averages in 1/16 us
+        uint32_t avgCharCost16 = 0;
+        uint32_t avgMoveCost16 = 0;
+        uint32_t lastSliceInUs = 0;
+
+        static inline void updateAverage16( uint32_t &avg16, uint32_t sampleInUs ) {
+            int32_t sample16 = sampleInUs << 4;
+            if ( avg16 == 0 )
+                avg16 = sample16;
+            else
+                avg16 += ( sample16 - (int32_t) avg16 ) / 8;
+        }
+
+        inline void recordSlice( uint32_t startInUs ) {
+            lastSliceInUs = micros() - startInUs;
+            if ( lastSliceInUs > stats.maxSliceInUs ) stats.maxSliceInUs = lastSliceInUs;
+        }
+
+    public:
+
         void setUpdateThrottleInMs( uint16_t timeInMs ) {
             btsThrottleInMs = timeInMs;
             // set time in the past so next call will update at once
@@ -766,6 +1313,63 @@ class LCDBuffered : public LCDInterface {
             return btsThrottleInMs;
         }
 
+        // characters marked changed but not yet compared, rough estimate
+        // spans of user side and screen side may overlap
+        // ex. to share time between displays, see LCDBufferedGroup
+        uint16_t getPendingCount() {
+            if ( bufferSize == 0 ) return 0;
+            uint16_t r = 0;
+            bool carried = bufferMode == doubleBuffer && pickedGeneration.load() != publishedGeneration;
+            for( uint8_t i = 0 ; i < maxRows ; i++ ) {
+                if ( !userDirty[i].isClean() ) r += userDirty[i].end - userDirty[i].start;
+                if ( !btsDirty[i].isClean()  ) r += btsDirty[i].end  - btsDirty[i].start;
+                if ( carried && !pendingDirty[i].isClean() ) r += pendingDirty[i].end - pendingDirty[i].start;
+            }
+            return r;
+        }
+
+        // changes inside priority regions are sent first on every refreshPartial()
+        // before continuing the rest of the screen, ex. live value beside a gauge
+        // keep regions small, they are not limited by updateDurationInMs
+        static const uint8_t MAX_PRIORITY_REGIONS = 4;
+
+        bool addPriorityRegion( uint8_t col1, uint8_t row1, uint8_t col2, uint8_t row2 ) {
+            if ( priorityRegionCount >= MAX_PRIORITY_REGIONS ) return false;
+            if ( col1 > col2 || row1 > row2 ) return false;
+            if ( col1 >= maxColumns || row1 >= maxRows ) return false;
+            if ( col2 >= maxColumns ) col2 = maxColumns - 1;
+            if ( row2 >= maxRows ) row2 = maxRows - 1;
+            priorityRegions[ priorityRegionCount++ ] = { col1, row1, col2, row2 };
+            return true;
+        }
+        inline void clearPriorityRegions() {
+            priorityRegionCount = 0;
+        }
+        inline uint8_t getPriorityRegionCount() { return priorityRegionCount; }
+
+    private:
+
+        void clipPriorityRegions() {
+            // after resize, drop regions outside, clip the rest
+            uint8_t kept = 0;
+            for( uint8_t i = 0 ; i < priorityRegionCount ; i++ ) {
+                priorityRegion r = priorityRegions[i];
+                if ( r.col1 >= maxColumns || r.row1 >= maxRows ) continue;
+                if ( r.col2 >= maxColumns ) r.col2 = maxColumns - 1;
+                if ( r.row2 >= maxRows ) r.row2 = maxRows - 1;
+                priorityRegions[ kept++ ] = r;
+            }
+            priorityRegionCount = kept;
+        }
+
+        struct priorityRegion {
+            uint8_t col1, row1, col2, row2;
+        };
+        priorityRegion priorityRegions[ MAX_PRIORITY_REGIONS ];
+        uint8_t priorityRegionCount = 0;
+
+    public:
+
         // enum updateResult {
         //     Timeout,        // screen not yet fully updated
         //     Completed,      // screen fully updated
@@ -777,37 +1381,55 @@ class LCDBuffered : public LCDInterface {
         // LCDInterface::updateResult update() override {
         LCDInterface::updateResult refreshPartial() override {
             // send updates to LCD
-            
+            // refresh task is doing the updates, see startRefreshTask()
+            if ( refreshTaskRunning ) return Throttling;
+            return refreshPartialCore();
+        }
+
+    private:
+
+        updateResult refreshPartialCore() {
             if ( bufferSize == 0 ) return NotInitialized;
 
+            uint32_t sliceStart = micros();
+
             if ( btsMode == mStart ) {
                 if ( btsThrottleInMs != 0 ) {
                     if ( millis() - btsLastCompletedUpdate < btsThrottleInMs ) {
                         //Serial.print( "." );
+                        stats.throttled++;
                         return Throttling;
                     }
                 }
                 if ( bufferMode == doubleBuffer ) {
-                    if ( !fetchBtsBuffer() ) {
-                        //Serial.print( "L" );
-                        return BufferLock;
-                    }
+                    fetchBtsBuffer();
+                } else {
+                    fetchDirtySpans();
                 }
+                applyViewport();
                 btsMode = mRunning;
-                btsPtr = 0; btsCursorX = 0; btsCursorY = 0;
+                btsCursorX = 0; btsCursorY = 0;
                 //Serial.print( "u" );
             
             } // else btsMode == mRunning...
 
-            if ( updateScreenCore( true ) ) {
+            // glyphs no longer shown by old cells can go at once
+            // others wait until text using the old glyph is replaced
+            uploadGlyphs( true, true, sliceStart );
+            bool completed = updateScreenCore( true, sliceStart );
+            if ( completed ) completed = uploadGlyphs( false, true, sliceStart );
+            recordSlice( sliceStart );
+            if ( completed ) {
                 // done sending btsBuffer to screen
                 btsMode = mStart;
                 btsLastCompletedUpdate = millis();
                 //Serial.print( "c" );
+                stats.framesCompleted++;
                 return Completed;
             } else {
                 // timeout before finishing full screen
                 //Serial.print( "t" );
+                stats.framesTimedOut++;
                 return Timeout;
             }
         }
@@ -819,44 +1441,147 @@ class LCDBuffered : public LCDInterface {
             // send updates to LCD without timeout
             if ( bufferSize == 0 ) return NotInitialized;
             if ( bufferMode == doubleBuffer ) {
-                if ( !fetchBtsBuffer() ) return BufferLock;
+                fetchBtsBuffer();
+            } else {
+                fetchDirtySpans();
             }
+            applyViewport();
             
             // reset pointers
-            btsPtr = 0; btsCursorX = 0; btsCursorY = 0;
+            btsCursorX = 0; btsCursorY = 0;
 
             // update without timeout
+            uploadGlyphs( true, false );
             updateScreenCore( false );
+            uploadGlyphs( false, false );
 
             btsMode = mStart;
             btsLastCompletedUpdate = millis();
+            stats.framesCompleted++;
             return Completed;
         }
 
     public:
 
-        inline void refresh() override { refreshCore(); }
+        inline void refresh() override {
+            // refresh task is doing the updates, see startRefreshTask()
+            if ( refreshTaskRunning ) return;
+            refreshCore();
+        }
 
     private:
 
-        bool fetchBtsBuffer() {
-            // copy userBuffer to btsBuffer for updating
-            // https://www.freertos.org/a00122.html
-            // xSemaphoreTake( userBufferSem, portMAX_DELAY );
-            if ( userBufferSem.take( SEM_ID_copyUserBuffer ) ) {
-            // if ( xSemaphoreTake( userBufferSem, semLockTimeout ) == pdTRUE ) {
-                memcpy( btsBuffer, userBuffer, bufferSize );
-                userBufferSem.release( SEM_ID_copyUserBuffer );
-                // xSemaphoreGive( userBufferSem );
-                processVirtualCursor_DoubleBuffer();
-                return true;
-            } else {
-                // semaphore timeout, in case user forgot to call resumeUpdate()
-                return false;
-            }
+        void fetchDirtySpans() {
+            // move user changes to spans to be sent
+            // if previous update was not finished (eg. refresh() called midway)
+            // remaining spans are merged
+            // single buffer only, double buffer takes spans with frame
+            mergeSpans( btsDirty, userDirty );
+            cleanSpans( userDirty );
+            btsGlyphDirty |= userGlyphDirty;
+            userGlyphDirty = 0;
+            markVirtualCursorDirty();
+        }
+
+        void fetchBtsBuffer() {
+            // take latest frame for updating, no copying or locking
+            // single core: publish user updates so far
+            if ( !publishOnResume ) publishFrame();
+            pickupFrame();
+            markVirtualCursorDirty();
         }
         
-        bool updateScreenCore( bool checkTimeout ) {
+        // run of changed characters not yet sent
+        // already updated in screenData, so send from there
+        uint16_t runPtr = 0;
+        uint8_t runLength = 0;
+        uint8_t runCursorX = 0, runCursorY = 0;
+
+        // unchanged characters after run, included in run if next character changed
+        // and rewriting them is cheaper than setCursor()
+        uint8_t gapLength = 0;
+
+        inline void flushRun() {
+            if ( runLength == 0 ) return;
+            // new run always starts after unchanged character or on new row
+            // note: setCursor sends additional 1 byte thru i2c
+            uint32_t t0 = micros();
+            lcd->setCursor( runCursorX, runCursorY );
+            uint32_t t1 = micros();
+            lcd->write( (const uint8_t *) screenData + runPtr, runLength );
+            uint32_t t2 = micros();
+            updateAverage16( avgMoveCost16, t1 - t0 );
+            updateAverage16( avgCharCost16, ( t2 - t1 ) / runLength );
+            stats.cursorMoves++;
+            stats.charsWritten += runLength;
+            runLength = 0;
+            gapLength = 0;
+        }
+
+        inline void addToRun( uint16_t ptr, uint8_t col, uint8_t row, char ch, transportCost &cost ) {
+            // changed character, caller flushes run at end of row
+            // ptr, col and row are screen coordinates
+            if ( runLength == 0 ) {
+                runPtr = ptr;
+                runCursorX = col;
+                runCursorY = row;
+            } else if ( gapLength > 0 ) {
+                // bridge gap, unchanged characters are already in screenData
+                stats.bytesSavedByBridging += cost.setCursor - gapLength * cost.character;
+                runLength += gapLength;
+                gapLength = 0;
+            }
+            screenData[ptr] = ch;
+            runLength++;
+        }
+
+        inline void skipUnchanged( uint8_t maxGap ) {
+            if ( runLength == 0 ) return;
+            if ( gapLength < maxGap )
+                gapLength++;
+            else
+                flushRun();
+        }
+
+        inline bool exceedsAdaptiveBudget( uint32_t startInUs, bool progressMade ) {
+            // predict time if 1 more character is added to run
+            if ( !progressMade ) return false;
+            uint32_t pending = avgCharCost16 * ( runLength + gapLength + 1 );
+            if ( runLength == 0 ) pending += avgMoveCost16;
+            return ( micros() - startInUs ) + ( pending >> 4 ) > adaptiveUpdateInUs;
+        }
+
+        void updatePriorityRegions( transportCost &cost, uint8_t maxGap ) {
+            // send changes inside priority regions, not time limited
+            // rest of row is left to normal scan, which will find these unchanged
+            // regions are in canvas coordinates, only parts inside viewport are sent
+            uint8_t viewRight = viewX + screenColumns, viewBottom = viewY + screenRows;
+            for( uint8_t i = 0 ; i < priorityRegionCount ; i++ ) {
+                priorityRegion &r = priorityRegions[i];
+                uint8_t rowFrom = ( r.row1 > viewY ) ? r.row1 : viewY;
+                uint8_t rowTo   = ( r.row2 + 1 < viewBottom ) ? r.row2 + 1 : viewBottom;
+                for( uint8_t row = rowFrom ; row < rowTo ; row++ ) {
+                    dirtySpan &span = btsDirty[row];
+                    uint8_t from = ( span.start > r.col1 ) ? span.start : r.col1;
+                    uint8_t to   = ( span.end < r.col2 + 1 ) ? span.end : r.col2 + 1;
+                    if ( from < viewX ) from = viewX;
+                    if ( to > viewRight ) to = viewRight;
+                    const char *bts = rowOf( btsBuffer, row );
+                    uint16_t scrPtr = ( row - viewY ) * screenColumns + ( from - viewX );
+                    for( uint8_t col = from ; col < to ; col++, scrPtr++ ) {
+                        char ch = processVirtualCursor( col, row, bts[col] );
+                        if ( screenData[scrPtr] != ch )
+                            addToRun( scrPtr, col - viewX, row - viewY, ch, cost );
+                        else
+                            skipUnchanged( maxGap );
+                        stats.charsCompared++;
+                    }
+                    flushRun();
+                }
+            }
+        }
+
+        bool updateScreenCore( bool checkTimeout, uint32_t startInUs = 0 ) {
 
             // return:
             // true  - finished updating
@@ -864,54 +1589,256 @@ class LCDBuffered : public LCDInterface {
 
             uint32_t start;
             if ( checkTimeout ) start = millis();
+            bool useBudget = checkTimeout && adaptiveUpdateInUs != 0;
+            bool progressMade = false;
 
-            // no need to reposition cursor if previous character
-            // was updated, LCD screen will move cursor automatically
-            // note: setCursor sends additional 1 byte thru i2c
-            bool moveLCDCursor = true;
+            // longest gap of unchanged characters worth rewriting
+            transportCost cost = lcd->getTransportCost();
+            uint8_t maxGap = ( cost.character == 0 ) ? 0 : cost.setCursor / cost.character;
+
+            // priority regions first, rest of screen gets remaining time
+            if ( checkTimeout ) updatePriorityRegions( cost, maxGap );
+
+            // consecutive changed characters are sent as one run
+            // LCD screen will move cursor automatically
             uint8_t ch;
 
-            while( true ) {
+            // btsCursorY is LCD row, btsCursorX is canvas column
+            // changes outside viewport are dropped, panning compares everything shown
+            uint8_t viewRight = viewX + screenColumns;
+
+            while( btsCursorY < screenRows ) {
+                // visit only changed spans
+                uint8_t canvasRow = viewY + btsCursorY;
+                dirtySpan &span = btsDirty[canvasRow];
+                if ( btsCursorX < span.start )
+                    btsCursorX = span.start;
+                if ( btsCursorX < viewX )
+                    btsCursorX = viewX;
+                if ( btsCursorX >= span.end || btsCursorX >= viewRight ) {
+                    // row done, proceed to next
+                    flushRun();
+                    span.setClean();
+                    btsCursorX = 0;
+                    btsCursorY++;
+                    continue;
+                }
+                const char *bts = rowOf( btsBuffer, canvasRow );
+                uint16_t scrPtr = btsCursorY * screenColumns + ( btsCursorX - viewX );
                 // keep copy, it changes if singleBuffer/multiCore
-                // ch = btsBuffer[btsPtr];
-                if ( bufferMode == singleBuffer ) {
-                    ch = processVirtualCursor_SingleBuffer( btsCursorX, btsCursorY, btsBuffer[btsPtr] );
+                // virtual cursor is not written to btsBuffer, so it can be shared
+                ch = processVirtualCursor( btsCursorX, canvasRow, bts[btsCursorX] );
+                if ( screenData[scrPtr] != ch ) {
+                    if ( useBudget && exceedsAdaptiveBudget( startInUs, progressMade ) ) {
+                        // continue from this character on next call
+                        flushRun();
+                        span.start = btsCursorX;
+                        return false;
+                    }
+                    progressMade = true;
+                    addToRun( scrPtr, btsCursorX - viewX, btsCursorY, ch, cost );
                 } else {
-                    ch = btsBuffer[btsPtr];
+                    skipUnchanged( maxGap );
                 }
-                if ( screenData[btsPtr] != ch ) {
-                    if ( moveLCDCursor )
-                        lcd->setCursor( btsCursorX, btsCursorY );
-                    lcd->write( ch );
-                    //if ( bufferMode == singleBuffer )
-                        screenData[btsPtr] = ch;
-                    moveLCDCursor = false;
-                } else {
-                    moveLCDCursor = true;
+                btsCursorX++;
+                stats.charsCompared++;
+                if ( checkTimeout && !useBudget && ( millis() - start >= updateDurationInMs ) ) {
+                    // continue from here on next call
+                    flushRun();
+                    span.start = btsCursorX;
+                    return false;
                 }
-                btsPtr++;
-                if ( btsPtr >= bufferSize ) {
-                    //if ( bufferMode == doubleBuffer ) {
-                    //    // update screenData by swapping buffers
-                    //    char *tPtr = screenData; screenData = btsBuffer; btsBuffer = tPtr;
-                    //}
-                    return true;
-                } else {
-                    btsCursorX++;
-                    if ( btsCursorX >= maxColumns ) {
-                        btsCursorX = 0;
-                        btsCursorY++;
-                        // won't reach this point
-                        // if ( btsCursorY >= maxRows ) btsCursorY = 0;
-                        moveLCDCursor = true;
-                    }
+            }
+            return true;
+        }
+
+
+    //
+    // CUSTOM CHARACTERS
+    //
+    private:
+
+        // bitmaps are kept after text of each buffer, see CGRAM_SIZE
+        // - user side marks changed slots, carried by published frames
+        // - screen update uploads them in between text
+        // - a slot is not rewritten while LCD still shows its old glyph
+        //   in cells the frame being sent has changed, those are sent first
+        uint8_t userGlyphDefined = 0;           // user side: createChar() called
+        uint8_t userGlyphDirty   = 0;           // user side: changed since last publish
+        uint8_t btsGlyphDirty    = 0;           // screen side: to be uploaded
+        uint8_t screenGlyph[ CGRAM_SIZE ];      // screen side: bitmaps already in LCD
+        uint8_t screenGlyphValid = 0;
+
+        bool isOldGlyphShown( uint8_t slot ) {
+            // codes 8-15 show same glyph as 0-7
+            for( uint8_t row = 0 ; row < screenRows ; row++ ) {
+                const char *scr = screenData + row * screenColumns;
+                const char *bts = rowOf( btsBuffer, viewY + row ) + viewX;
+                for( uint8_t col = 0 ; col < screenColumns ; col++ ) {
+                    if ( ( scr[col] & 0xF7 ) != slot ) continue;
+                    if ( ( bts[col] & 0xF7 ) != slot ) return true;
                 }
-                if ( checkTimeout && ( millis() - start >= updateDurationInMs ) ) {
-                    return false;
+            }
+            return false;
+        }
+
+        bool uploadGlyphs( bool onlyIfNotShown, bool checkTimeout, uint32_t startInUs = 0 ) {
+
+            // return:
+            // true  - all pending glyphs uploaded
+            // false - some left for next call
+
+            if ( btsGlyphDirty == 0 ) return true;
+            uint32_t budgetInUs = adaptiveUpdateInUs != 0 ? adaptiveUpdateInUs : updateDurationInMs * 1000UL;
+            const char *glyphs = btsBuffer + bufferSize;
+            bool uploaded = false;
+            for( uint8_t slot = 0 ; slot < 8 ; slot++ ) {
+                uint8_t mask = 1 << slot;
+                if ( !( btsGlyphDirty & mask ) ) continue;
+                if ( onlyIfNotShown && isOldGlyphShown( slot ) ) continue;
+                const char *glyph = glyphs + slot * 8;
+                if ( ( screenGlyphValid & mask ) && memcmp( screenGlyph + slot * 8, glyph, 8 ) == 0 ) {
+                    btsGlyphDirty &= ~mask;
+                    stats.glyphUploadsSkipped++;
+                    continue;
                 }
+                // at least 1 per call, so it always progresses
+                if ( checkTimeout && uploaded && micros() - startInUs >= budgetInUs ) return false;
+                // note: moves LCD cursor, next run always starts with setCursor()
+                lcd->createChar( slot, glyph );
+                memcpy( screenGlyph + slot * 8, glyph, 8 );
+                screenGlyphValid |= mask;
+                btsGlyphDirty &= ~mask;
+                stats.glyphUploads++;
+                uploaded = true;
+            }
+            return btsGlyphDirty == 0;
+        }
+
+    //
+    // REFRESH TASK
+    //
+    private:
+
+        volatile bool refreshTaskRunning = false;   // refresh()/refreshPartial() are ignored
+        spAtomic<bool> refreshTaskStop { false };
+        uint16_t refreshTaskIdleInMs     = 1;
+
+        // backlight/display changes from user side, sent by refresh task
+        static const uint8_t stateNone = 0, stateOn = 1, stateOff = 2;
+        spAtomic<uint8_t> requestedBacklight { stateNone };
+        spAtomic<uint8_t> requestedDisplay   { stateNone };
+
+        void applyRequestedStates() {
+            uint8_t b = requestedBacklight.exchange( stateNone );
+            if ( b == stateOn )  lcd->backlightOn();
+            if ( b == stateOff ) lcd->backlightOff();
+            uint8_t d = requestedDisplay.exchange( stateNone );
+            if ( d == stateOn )  lcd->displayOn();
+            if ( d == stateOff ) lcd->displayOff();
+        }
+
+        #if defined(ESP32)
+            TaskHandle_t refreshTaskHandle = nullptr;
+            spAtomic<bool> refreshTaskDone { false };
+        #elif !defined(ARDUINO)
+            std::thread *refreshThread = nullptr;
+        #endif
+
+        void refreshTaskLoop() {
+            // same as calling refreshPartial() from loop()
+            // rest only when there is nothing to do, so other tasks can run
+            while( !refreshTaskStop.load() ) {
+                if ( resetRequested.exchange( false ) )
+                    resetCore();
+                recoverCore();
+                applyRequestedStates();
+                updateResult r = refreshPartialCore();
+                if ( r == Timeout ) continue;
+                #if defined(ESP32)
+                    vTaskDelay( refreshTaskIdleInMs / portTICK_PERIOD_MS + 1 );
+                #elif !defined(ARDUINO)
+                    std::this_thread::sleep_for( std::chrono::milliseconds( refreshTaskIdleInMs ) );
+                #endif
+            }
+        }
+
+        #if defined(ESP32)
+            static void refreshTaskEntry( void *param ) {
+                LCDBuffered *self = (LCDBuffered *) param;
+                self->refreshTaskLoop();
+                self->refreshTaskDone.store( true );
+                vTaskDelete( nullptr );
             }
+        #endif
+
+    public:
+
+        //  Send updates from a dedicated task, user code only publishes frames
+        //  - ESP32             : FreeRTOS task pinned to [core]
+        //  - host builds       : std::thread, [core] ignored
+        //  - other platforms   : not supported, returns false
+        //
+        //  - switches to double buffer, changes are sent only after resumeUpdate()
+        //  - refresh(), refreshPartial(), reset() and recoverIfHasError() are
+        //    handled by the task while running
+        //  - backlightOn/Off() and displayOn/Off() are sent by the task
+        //  - begin(), setCanvasSize(), useSingleBuffer() and command() are ignored
+        //  - task owns the LCD, do not send commands to it directly
+        //
+        //      lcd.startRefreshTask( 0 );
+        //      void loop() {
+        //          lcd.pauseUpdate();
+        //          lcd.setCursor( 0, 0 );
+        //          lcd.print( analogRead( A0 ) );
+        //          lcd.resumeUpdate();
+        //      }
+
+        bool startRefreshTask( uint8_t core = 0, uint16_t idleInMs = 1, uint32_t stackSize = 2048, uint8_t priority = 1 ) {
+            if ( bufferSize == 0 || refreshTaskRunning ) return false;
+            useDoubleBuffer();
+            publishOnResume = true;
+            refreshTaskIdleInMs = idleInMs;
+            refreshTaskStop.store( false );
+            refreshTaskRunning = true;
+            #if defined(ESP32)
+                refreshTaskDone.store( false );
+                if ( xTaskCreatePinnedToCore( refreshTaskEntry, "LCDBuffered", stackSize,
+                        this, priority, &refreshTaskHandle, core ) != pdPASS ) {
+                    refreshTaskHandle = nullptr;
+                    refreshTaskRunning = false;
+                    return false;
+                }
+            #elif !defined(ARDUINO)
+                (void) core; (void) stackSize; (void) priority;
+                refreshThread = new std::thread( [this]() { refreshTaskLoop(); } );
+            #else
+                (void) core; (void) stackSize; (void) priority;
+                refreshTaskRunning = false;
+                return false;
+            #endif
+            return true;
         }
 
+        void stopRefreshTask() {
+            // wait for current slice to finish
+            if ( !refreshTaskRunning ) return;
+            refreshTaskStop.store( true );
+            #if defined(ESP32)
+                while( !refreshTaskDone.load() ) delay( 1 );
+                refreshTaskHandle = nullptr;
+            #elif !defined(ARDUINO)
+                refreshThread->join();
+                delete refreshThread;
+                refreshThread = nullptr;
+            #endif
+            refreshTaskRunning = false;
+            // requests not yet picked up by task
+            applyRequestedStates();
+        }
+
+        inline bool isRefreshTaskRunning() { return refreshTaskRunning; }
+
 };
 
 //
@@ -1042,13 +1969,16 @@ class LCDBuffered : public LCDInterface {
         case 0: return lcd->userBuffer;
         case 1: return lcd->btsBuffer;
         case 2: return lcd->screenData;
+        case 3: return (char *) lcd->rowMapOf( lcd->userBuffer );
+        case 4: return (char *) lcd->rowMapOf( lcd->btsBuffer );
         }
         return nullptr;
     }
 
-    void TEST_bufferedSpeedDisplay( LCDBuffered *lcd, char *buffer ) {
-        uint8_t ptr = 0;
+    void TEST_bufferedSpeedDisplay( LCDBuffered *lcd, char *buffer, char *rowMap = nullptr ) {
+        // rowMap: storage row of each row, screenData has none
         for( int i = 0 ; i < lcd->maxRows ; i++ ) {
+            uint16_t ptr = ( rowMap == nullptr ? i : (uint8_t) rowMap[i] ) * lcd->maxColumns;
             for( int j = 0 ; j < lcd->maxColumns ; j++ )
                 Serial.write( buffer[ ptr++ ] );
             Serial.println();
@@ -1072,6 +2002,7 @@ class LCDBuffered : public LCDInterface {
         lcd->cursorBlinkOn();
         lcd->setVirtualCursor(7,0);
 
+        lcd->resetRefreshStats();
         uint32_t start = millis();
         uint32_t n = 0;
         while( n <= count ) {
@@ -1097,11 +2028,18 @@ class LCDBuffered : public LCDInterface {
         Serial.print( " = " );
         Serial.println( elapsed );
         // Serial.printf( "%dms / %d = %d\n", throttleInMs, count, elapsed );
+        lcd->printRefreshStats( Serial );
+        LCDBuffered::refreshStats stats = lcd->getRefreshStats();
+        if ( stats.charsCompared != 0 ) {
+            // how much of what was checked actually went to the LCD
+            Serial.print( "written / compared % = " );
+            Serial.println( stats.charsWritten * 100 / stats.charsCompared );
+        }
         if ( showResults ) {
             Serial.println( "userBuffer" );
-            TEST_bufferedSpeedDisplay( lcd, LCDBuffered_internalAccess( lcd, 0 ) );
+            TEST_bufferedSpeedDisplay( lcd, LCDBuffered_internalAccess( lcd, 0 ), LCDBuffered_internalAccess( lcd, 3 ) );
             Serial.println( "btsBuffer" );
-            TEST_bufferedSpeedDisplay( lcd, LCDBuffered_internalAccess( lcd, 1 ) );
+            TEST_bufferedSpeedDisplay( lcd, LCDBuffered_internalAccess( lcd, 1 ), LCDBuffered_internalAccess( lcd, 4 ) );
             Serial.println( "screenData" );
             TEST_bufferedSpeedDisplay( lcd, LCDBuffered_internalAccess( lcd, 2 ) );
         }
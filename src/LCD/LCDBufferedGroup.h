@@ -0,0 +1,141 @@
+//  LCD Buffered Group
+//  ------------------
+//  - several LCDBuffered sharing one time budget, ex. multiple i2c LCDs on one bus
+//  - calling refreshPartial() of each one adds up their updateDurationInMs
+//    and they compete for the bus, group splits a single budget instead
+//
+//  To Use
+//
+//      LCDBuffered_i2c lcd1( 0x27 );
+//      LCDBuffered_i2c lcd2( 0x26 );
+//      LCDBufferedGroup displays;
+//
+//      void setup() {
+//          lcd1.begin( 20, 4 );
+//          lcd2.begin( 16, 2 );
+//          displays.add( lcd1 );
+//          displays.add( lcd2 );
+//          displays.updateDurationInUs = 2000;   // for all displays
+//      }
+//      void loop() {
+//          ...
+//          displays.refreshPartial();
+//      }
+//
+//  Budget Modes
+//
+//      byPendingCount      share in proportion to changed characters, default
+//                          idle displays still get a turn for throttling, blinking...
+//      roundRobin          equal share
+//
+//      first display served rotates on each call, budget left unused passes to the next
+//      if budget runs out, remaining displays wait for next call
+//
+//  Same contents on several LCDs, see LCDMirror (compared once, sent to all)
+//
+//  Notes
+//
+//      each display's own updateDurationInMs and adaptiveUpdateInUs are replaced
+//      while the group is updating it, throttling still applies per display
+
+#pragma once
+
+#include <LCD/LCDBuffered.h>
+
+namespace StarterPack {
+
+class LCDBufferedGroup {
+
+    public:
+
+        static const uint8_t MAX_DISPLAYS = 4;
+
+        enum budgetModes {
+            byPendingCount, roundRobin
+        };
+        budgetModes budgetMode = byPendingCount;
+
+        // shared by all displays on each refreshPartial()
+        uint16_t updateDurationInUs = 2000;
+
+        bool add( LCDBuffered &lcd ) {
+            if ( displayCount >= MAX_DISPLAYS ) return false;
+            displays[ displayCount++ ] = &lcd;
+            return true;
+        }
+        inline uint8_t getDisplayCount() { return displayCount; }
+
+    private:
+
+        LCDBuffered *displays[ MAX_DISPLAYS ];
+        uint8_t displayCount = 0;
+        uint8_t nextDisplay = 0;
+
+        static const uint16_t NOT_DIRTY_WEIGHT = 1;
+
+    public:
+
+        LCDInterface::updateResult refreshPartial() {
+
+            // return:
+            // Timeout        - some display not yet fully updated
+            // Completed      - at least 1 finished, none left midway
+            // Throttling     - all throttled
+            // NotInitialized - none initialized
+
+            if ( displayCount == 0 ) return LCDInterface::NotInitialized;
+
+            uint32_t start = micros();
+            uint8_t first = nextDisplay;
+            nextDisplay = ( nextDisplay + 1 ) % displayCount;
+
+            // weights, so each share is computed from what is left
+            uint16_t weight[ MAX_DISPLAYS ];
+            uint32_t totalWeight = 0;
+            for( uint8_t i = 0 ; i < displayCount ; i++ ) {
+                weight[i] = NOT_DIRTY_WEIGHT;
+                if ( budgetMode == byPendingCount ) weight[i] += displays[i]->getPendingCount();
+                totalWeight += weight[i];
+            }
+
+            bool anyTimeout = false, anyCompleted = false, anyThrottled = false;
+            for( uint8_t n = 0 ; n < displayCount ; n++ ) {
+                uint8_t i = ( first + n ) % displayCount;
+                uint32_t elapsed = micros() - start;
+                if ( elapsed >= updateDurationInUs ) {
+                    // out of time, rest wait for next call
+                    anyTimeout = true;
+                    break;
+                }
+                uint32_t share = ( updateDurationInUs - elapsed ) * weight[i] / totalWeight;
+                if ( share == 0 ) share = 1;
+                totalWeight -= weight[i];
+
+                LCDBuffered *lcd = displays[i];
+                uint16_t saveAdaptive = lcd->adaptiveUpdateInUs;
+                lcd->adaptiveUpdateInUs = share;
+                LCDInterface::updateResult r = lcd->refreshPartial();
+                lcd->adaptiveUpdateInUs = saveAdaptive;
+
+                switch( r ) {
+                    case LCDInterface::Timeout:     anyTimeout   = true; break;
+                    case LCDInterface::Completed:   anyCompleted = true; break;
+                    case LCDInterface::Throttling:  anyThrottled = true; break;
+                    default: break;
+                }
+            }
+            if ( anyTimeout   ) return LCDInterface::Timeout;
+            if ( anyCompleted ) return LCDInterface::Completed;
+            if ( anyThrottled ) return LCDInterface::Throttling;
+            return LCDInterface::NotInitialized;
+        }
+
+        void refresh() {
+            // send everything, no time limit
+            for( uint8_t i = 0 ; i < displayCount ; i++ )
+                displays[i]->refresh();
+        }
+
+};
+
+}
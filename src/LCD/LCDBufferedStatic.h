@@ -0,0 +1,43 @@
+//  LCD Buffered with Fixed Storage
+//  -------------------------------
+//  - same as LCDBuffered, but buffers are member arrays sized at compile time
+//  - no heap allocation, no fragmentation on long running units
+//  - RAM usage shown at link time
+//  - begin() with larger screen than COLS x ROWS is ignored (NotInitialized)
+//
+//  To Use
+//
+//      LCD_i2c lcdDirect( 0x27 );
+//      LCDBufferedStatic<20,4> lcd( lcdDirect );
+//      ...
+//      lcd.begin( 20, 4 );
+//
+//  RAM
+//
+//      4 x COLS x ROWS characters (3 for triple buffering, 1 for screen data)
+//      + 3 x 64 bytes for custom character bitmaps
+//      + 3 x ROWS bytes for row maps
+//      + 18 x ROWS bytes for changed spans
+
+#pragma once
+
+#include <LCD/LCDBuffered.h>
+
+namespace StarterPack {
+
+template <uint8_t COLS, uint8_t ROWS>
+class LCDBufferedStatic : public LCDBuffered {
+
+        static_assert( COLS > 0 && ROWS > 0, "LCDBufferedStatic: invalid screen size" );
+
+        char storage[ 4 * COLS * ROWS + 3 * ( CGRAM_SIZE + ROWS ) ];
+        dirtySpan spanStorage[ SPANS_PER_ROW * ROWS ];
+
+    public:
+
+        inline LCDBufferedStatic( LCDInterface &lcd, uint16_t throttleTimeInMs = 50, uint16_t updateDurationInMs = 10 )
+        : LCDBuffered( lcd, storage, spanStorage, COLS * ROWS, ROWS, throttleTimeInMs, updateDurationInMs ) {}
+
+};
+
+}
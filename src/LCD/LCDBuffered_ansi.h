@@ -0,0 +1,23 @@
+#pragma once
+
+#include <LCD/LCD_ansi.h>
+#include <LCD/LCDBuffered.h>
+
+namespace StarterPack {
+
+class LCDBuffered_ansi : public LCDBuffered {
+
+    public:
+
+        // lcd is deleted by LCDBuffered (mustDeletedLCD)
+
+        inline LCDBuffered_ansi( Print &out ) {
+            lcd = new LCD_ansi( out );
+        }
+
+        // bytes sent to terminal, ex. cost of drawing a screen
+        inline LCD_ansi &terminal() { return *(LCD_ansi *) lcd; }
+
+};
+
+}
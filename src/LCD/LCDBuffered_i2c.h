@@ -9,9 +9,7 @@ class LCDBuffered_i2c : public LCDBuffered {
 
     public:
 
-        ~LCDBuffered_i2c() {
-            delete lcd;
-        }
+        // lcd is deleted by LCDBuffered (mustDeletedLCD)
 
         inline LCDBuffered_i2c( int16_t i2cAddress = -1 ) {
             // use default global "Wire"
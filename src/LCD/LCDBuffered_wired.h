@@ -13,9 +13,7 @@ class LCDBuffered_wired : public LCDBuffered {
 
     public:
 
-        ~LCDBuffered_wired() {
-            delete lcd;
-        }
+        // lcd is deleted by LCDBuffered (mustDeletedLCD)
 
         #if defined( LCD_USE_8BIT_PORT )
             #if defined( LCD_READ_WRITE_MODE )
@@ -18,6 +18,7 @@
 //      void reset()                         reset device to initial state
 //
 //      bool isBuffered()                    returns true if buffered
+//      bool isCharCodeInUse( charCode )     true if custom character is still in buffer
 //      void displayAll()                    send all buffered changes immediately to screen
 //
 //  I2C Specific (ignored if wired LCD)
@@ -52,6 +53,7 @@
 //      createChar( location, charmap[] )   create special characters
 //      command( value )                    direct command to LCD
 //      write( ch )                         write single character
+//      write( buffer, size )               write run of characters, drivers may send all at once
 //      print( ... )                        all capabilities in <Print.h>
 //
 //  Additional functions
@@ -149,6 +151,20 @@ class LCDInterface : public Print {
         // eg. call in a loop to minimize processing impact
         inline virtual updateResult refreshPartial() { return NotInitialized; }
 
+        // cost of sending to LCD, in bytes on the bus
+        // used by buffered LCD to decide if rewriting unchanged characters
+        // is cheaper than moving the cursor over them
+        struct transportCost {
+            uint8_t setCursor;  // cost of repositioning cursor
+            uint8_t character;  // cost of each character within a run
+        };
+
+        inline virtual transportCost getTransportCost() { return { 1, 1 }; }
+
+        // true if custom character code (0-7, or alias 8-15) is still in buffer
+        // so it is not replaced while on screen, unbuffered LCD cannot tell
+        inline virtual bool isCharCodeInUse( uint8_t charCode ) { return false; }
+
     //
     // USER COMMANDS
     //
@@ -241,6 +257,11 @@ class LCDInterface : public Print {
 
         virtual void command( uint8_t value ) = 0;
 
+        // write run of characters starting at current position
+        // default from <Print.h> calls write( ch ) for each character
+        // drivers override to send all at once, ex. LCD_i2c packs into one transmission
+        using Print::write;
+
     //
     // EXTENSIONS
     //
@@ -0,0 +1,150 @@
+//  LCD Mirror
+//  ----------
+//  - same contents on several LCDs of the same size
+//  - wrap with LCDBuffered so changes are found once and sent to every panel
+//
+//  To Use
+//
+//      LCD_i2c panel1( 0x27 );
+//      LCD_i2c panel2( 0x26 );
+//      LCDMirror mirror;
+//      mirror.add( panel1 );
+//      mirror.add( panel2 );
+//      mirror.begin( 20, 4 );             // begins all panels
+//
+//      LCDBuffered lcd( mirror );
+//      lcd.print( "hello" );
+//      lcd.refreshPartial();              // 1 compare, sent to both
+//
+//  Notes
+//
+//      getTransportCost() is the sum of all panels, each run is sent to each of them
+//      recoverIfHasError() recovers any panel, LCDBuffered then resends to all
+
+#pragma once
+
+#include <LCD/LCDInterface.h>
+
+namespace StarterPack {
+
+class LCDMirror : public LCDInterface {
+
+    public:
+
+        static const uint8_t MAX_PANELS = 4;
+
+        bool add( LCDInterface &panel ) {
+            if ( panelCount >= MAX_PANELS ) return false;
+            panels[ panelCount++ ] = &panel;
+            return true;
+        }
+        inline uint8_t getPanelCount() { return panelCount; }
+
+    private:
+
+        LCDInterface *panels[ MAX_PANELS ];
+        uint8_t panelCount = 0;
+
+    public:
+
+        void setTimeoutInMs( uint16_t timeOut ) override {
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->setTimeoutInMs( timeOut );
+        }
+        void setFrequency( uint32_t frequency ) override {
+            // panels usually share the bus, last one wins
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->setFrequency( frequency );
+        }
+
+        void begin( uint8_t cols, uint8_t lines, charDotSize dotSize = charDotSize::size5x8 ) override {
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->begin( cols, lines, dotSize );
+            maxColumns = cols;
+            maxRows = lines;
+        }
+
+    //
+    // VERIFY / RECOVERY
+    //
+    public:
+
+        bool verify() override {
+            for( uint8_t i = 0 ; i < panelCount ; i++ )
+                if ( !panels[i]->verify() ) return false;
+            return true;
+        }
+        ERROR_NO verifyWithError() override {
+            // first error found
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) {
+                ERROR_NO r = panels[i]->verifyWithError();
+                if ( r != 0 ) return r;
+            }
+            return 0;
+        }
+        bool recoverIfHasError() override {
+            bool r = false;
+            for( uint8_t i = 0 ; i < panelCount ; i++ )
+                if ( panels[i]->recoverIfHasError() ) r = true;
+            return r;
+        }
+        void setRecoveryThrottleInMs( uint16_t delay ) override {
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->setRecoveryThrottleInMs( delay );
+        }
+        void reset() override {
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->reset();
+        }
+
+        transportCost getTransportCost() override {
+            transportCost r = { 0, 0 };
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) {
+                transportCost c = panels[i]->getTransportCost();
+                r.setCursor += c.setCursor;
+                r.character += c.character;
+            }
+            return r;
+        }
+
+    //
+    // STANDARD FUNCTIONS
+    //
+    public:
+
+        void clear()                            override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->clear(); }
+        void home()                             override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->home(); }
+        void setCursor( uint8_t col, uint8_t row ) override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->setCursor( col, row ); }
+        void backlightOn()                      override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->backlightOn(); }
+        void backlightOff()                     override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->backlightOff(); }
+        void displayOn()                        override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->displayOn(); }
+        void displayOff()                       override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->displayOff(); }
+        void cursorOn()                         override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->cursorOn(); }
+        void cursorOff()                        override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->cursorOff(); }
+        void cursorBlinkOn()                    override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->cursorBlinkOn(); }
+        void cursorBlinkOff()                   override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->cursorBlinkOff(); }
+        void moveCursorRight()                  override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->moveCursorRight(); }
+        void moveCursorLeft()                   override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->moveCursorLeft(); }
+        void scrollDisplayLeft()                override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->scrollDisplayLeft(); }
+        void scrollDisplayRight()               override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->scrollDisplayRight(); }
+        void leftToRight()                      override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->leftToRight(); }
+        void rightToLeft()                      override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->rightToLeft(); }
+        void autoscrollOn()                     override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->autoscrollOn(); }
+        void autoscrollOff()                    override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->autoscrollOff(); }
+        void command( uint8_t value )           override { for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->command( value ); }
+
+        void createChar( uint8_t charID, const uint8_t charmap[] ) override {
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->createChar( charID, charmap );
+        }
+        void createChar( uint8_t charID, const char *charmap ) override {
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->createChar( charID, charmap );
+        }
+
+        size_t write( uint8_t ch ) override {
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->write( ch );
+            return 1;
+        }
+        size_t write( const uint8_t *buffer, size_t size ) override {
+            // each panel gets whole run, drivers can send it at once
+            for( uint8_t i = 0 ; i < panelCount ; i++ ) panels[i]->write( buffer, size );
+            return size;
+        }
+
+};
+
+}
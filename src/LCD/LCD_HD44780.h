@@ -48,6 +48,12 @@ class LCD_HD44780 : public LCDInterface {
             // nibble on lower bits
         };
 
+        virtual void waitUntilReady( uint16_t worstCaseInUs ) {
+            // extra time needed by slow commands, eg. clear/home
+            // default is blind worst case delay, LCD_wired can poll busy flag instead
+            delayMicroseconds( worstCaseInUs );
+        }
+
         inline void beginCore( uint8_t maxColumns, uint8_t maxRows, charDotSize dotSize = charDotSize::size5x8 ) {
             // initialize LCD
             //  - set number of bits
@@ -94,14 +100,22 @@ class LCD_HD44780 : public LCDInterface {
                 // https://exploreembedded.com/wiki/Interfacing_LCD_in_4-bit_mode_with_8051
                 // sendNibble( 0x02 );
 
-                // use this if you are having problems
                 // original LiquidCrystal_I2C
                 // sendNibble( 0x03 ); delayMicroseconds(4500);
                 // sendNibble( 0x03 ); delayMicroseconds(4500);
                 // sendNibble( 0x03 ); delayMicroseconds(150);
                 // sendNibble( 0x02 );
 
-                command( (0x03 << 4) | 0x03 ); command( (0x03 << 4) | 0x02 );
+                // was: command( (0x03 << 4) | 0x03 ); command( (0x03 << 4) | 0x02 );
+                // LCD is in 8-bit mode after power on, or still in 4-bit mode after mcu reset
+                // until 4-bit mode is set each nibble is a whole instruction and needs its own wait
+                // both nibbles of command() are 2 bytes apart, too close on fast i2c (found with HD44780Sim)
+                sendNibble( 0x03 ); waitUntilReady( 4100 );
+                sendNibble( 0x03 ); waitUntilReady( 100 );
+                sendNibble( 0x03 ); waitUntilReady( 37 );
+                sendNibble( 0x02 ); waitUntilReady( 37 );
+                // now in 4-bit mode, set number of lines and font
+                command( com );
                 
             #endif
             
@@ -145,11 +159,11 @@ class LCD_HD44780 : public LCDInterface {
     
         inline void clear() override {
             command( LCD_CLEAR );
-            delayMicroseconds( 1520 - 37 ); // 1.52ms, command already has 37ms
+            waitUntilReady( 1520 - 37 ); // 1.52ms, command already has 37ms
         }
         inline void home() override {
             command( LCD_HOME );
-            delayMicroseconds( 1520 - 37 ); // 1.52ms, command already has 37ms
+            waitUntilReady( 1520 - 37 ); // 1.52ms, command already has 37ms
         }
 
     protected:
@@ -0,0 +1,193 @@
+//  LCD ANSI
+//  --------
+//  - LCD drawn on a terminal using ANSI escape sequences
+//  - any Print/Stream, ex. Serial to a terminal program, or stdout on host builds
+//  - no hardware needed, for bench rigs and CI
+//  - only cursor addressing, wrap with LCDBuffered so only changed cells are sent
+//
+//  To Use
+//
+//      LCDBuffered_ansi lcd( Serial );     // see LCDBuffered_ansi.h
+//      lcd.begin( 20, 4 );
+//
+//      LCD_ansi raw( Serial );             // unbuffered, every write is sent
+//      raw.begin( 16, 2 );
+//
+//  Options
+//
+//      uint8_t originColumn, originRow      top left of LCD on terminal, 1-based, at least 2,2 if with border
+//      bool drawBorder                      box around LCD on begin(), default true
+//
+//  Measuring
+//
+//      uint32_t bytesSent                   bytes written to output, including escape sequences
+//      resetBytesSent()
+//
+//      ex. lcd.refresh();                   // settle
+//          raw.resetBytesSent();
+//          menu.show();
+//          lcd.refresh();
+//          Serial.println( raw.bytesSent ); // cost of drawing menu
+//
+//  Rendering
+//
+//      custom characters 0-7 (and 8-15)     shown as digits in reverse video, bitmaps are ignored
+//      0xFF (full block)                    shown as '#'
+//      other non printable                  shown as '?'
+
+#pragma once
+#include <stdio.h>
+#include <LCD/LCDInterface.h>
+
+namespace StarterPack {
+
+class LCD_ansi : public LCDInterface {
+
+        Print *out;
+        uint8_t cursorX = 0, cursorY = 0;
+
+    public:
+
+        uint8_t originColumn = 1, originRow = 1;
+        bool drawBorder = true;
+
+        uint32_t bytesSent = 0;
+        inline void resetBytesSent() { bytesSent = 0; }
+
+        LCD_ansi( Print &out ) : out( &out ) {}
+
+        // no bus, nothing to configure
+        inline void setTimeoutInMs( uint16_t timeOut ) override {}
+        inline void setFrequency( uint32_t frequency ) override {}
+
+        void begin( uint8_t cols, uint8_t lines, charDotSize dotSize = charDotSize::size5x8 ) override {
+            maxColumns = cols;
+            maxRows = lines;
+            send( "\x1B[2J\x1B[?25l" );     // clear terminal, hide cursor
+            if ( drawBorder ) {
+                // border is outside of LCD area
+                if ( originColumn < 2 ) originColumn = 2;
+                if ( originRow < 2 ) originRow = 2;
+                moveTo( originColumn - 1, originRow - 1 );
+                sendBorderRow();
+                for( uint8_t i = 0 ; i < maxRows ; i++ ) {
+                    moveTo( originColumn - 1, originRow + i );
+                    sendByte( '|' );
+                    moveTo( originColumn + maxColumns, originRow + i );
+                    sendByte( '|' );
+                }
+                moveTo( originColumn - 1, originRow + maxRows );
+                sendBorderRow();
+            }
+            clear();
+        }
+
+    //
+    // VERIFY / RECOVERY
+    //
+    public:
+
+        // output cannot fail
+        inline bool verify() override { return true; }
+        inline ERROR_NO verifyWithError() override { return 0; }
+        inline bool recoverIfHasError() override { return false; }
+        inline void setRecoveryThrottleInMs( uint16_t delay ) override {}
+        inline void reset() override { clear(); }
+
+        // "ESC[rr;ccH" to move, 1 byte per character
+        inline transportCost getTransportCost() override { return { 8, 1 }; }
+
+    //
+    // STANDARD FUNCTIONS
+    //
+    public:
+
+        void clear() override {
+            for( uint8_t i = 0 ; i < maxRows ; i++ ) {
+                moveTo( originColumn, originRow + i );
+                for( uint8_t j = 0 ; j < maxColumns ; j++ )
+                    sendByte( ' ' );
+            }
+            home();
+        }
+        inline void home() override { setCursor( 0, 0 ); }
+
+        void setCursor( uint8_t col, uint8_t row ) override {
+            cursorX = col;
+            cursorY = row;
+            moveTo( originColumn + col, originRow + row );
+        }
+
+        // no backlight/display on terminal
+        inline void backlightOn()  override {}
+        inline void backlightOff() override {}
+        inline void displayOn()    override {}
+        inline void displayOff()   override {}
+
+        inline void cursorOn()       override { send( "\x1B[?25h" ); }
+        inline void cursorOff()      override { send( "\x1B[?25l" ); }
+        inline void cursorBlinkOn()  override {}    // terminal decides
+        inline void cursorBlinkOff() override {}
+
+        inline void moveCursorRight() override { setCursor( cursorX + 1, cursorY ); }
+        inline void moveCursorLeft()  override { if ( cursorX > 0 ) setCursor( cursorX - 1, cursorY ); }
+
+        // not supported
+        inline void scrollDisplayLeft()  override {}
+        inline void scrollDisplayRight() override {}
+        inline void leftToRight()        override {}
+        inline void rightToLeft()        override {}
+        inline void autoscrollOn()       override {}
+        inline void autoscrollOff()      override {}
+
+        // bitmaps are not shown, see Rendering
+        inline void createChar( uint8_t charID, const uint8_t charmap[] ) override {}
+        inline void createChar( uint8_t charID, const char *charmap ) override {}
+
+        inline void command( uint8_t value ) override {}
+
+        size_t write( uint8_t ch ) override {
+            // beyond right edge is not shown, HD44780 would write to hidden DDRAM
+            if ( cursorX < maxColumns && cursorY < maxRows ) {
+                if ( ch < 16 ) {
+                    char s[12];
+                    snprintf( s, sizeof( s ), "\x1B[7m%c\x1B[27m", '0' + ( ch & 0x07 ) );
+                    send( s );
+                } else if ( ch == 0xFF ) {
+                    sendByte( '#' );
+                } else if ( ch < ' ' || ch > '~' ) {
+                    sendByte( '?' );
+                } else {
+                    sendByte( ch );
+                }
+            }
+            cursorX++;
+            return 1;
+        }
+        using LCDInterface::write;
+
+    private:
+
+        inline void sendByte( uint8_t ch ) {
+            out->write( ch );
+            bytesSent++;
+        }
+        inline void send( const char *s ) {
+            while( *s ) sendByte( *s++ );
+        }
+        void moveTo( uint8_t col, uint8_t row ) {
+            // 1-based terminal position
+            char s[12];
+            snprintf( s, sizeof( s ), "\x1B[%d;%dH", row, col );
+            send( s );
+        }
+        void sendBorderRow() {
+            sendByte( '+' );
+            for( uint8_t j = 0 ; j < maxColumns ; j++ )
+                sendByte( '-' );
+            sendByte( '+' );
+        }
+
+};
+
+}
@@ -16,8 +16,15 @@
 //  To Use
 //
 //      LCD_i2c lcd = LCD_i2c( i2cAddress );
+//      lcd.setFrequency( 400000 );         // optional, bus timing is used to skip delays
 //      lcd.begin( 16, 2 );
 //
+//  Bus Speed
+//
+//      settling time of each character is taken from the frequency of the i2cHelper
+//      set thru lcd.setFrequency() or helper.setFrequency(), checked again on begin()/reset()
+//      if never set, clock is unknown and 1 character per transmission with delay is used
+//
 //  To Recover
 //
 //      void loop() {
@@ -74,6 +81,7 @@ class LCD_i2c : public LCD_HD44780 {
 
         inline void setFrequency( uint32_t frequency ) override {
             _wireHelper->setFrequency( frequency );
+            computeSettleTime( frequency );
         }
 
     //
@@ -103,6 +111,11 @@ class LCD_i2c : public LCD_HD44780 {
             // if VCC/GND was disconnected, LCD will revert to 8-bit data bus, so must reset
             begin( maxColumns, maxRows, dotSize );
         }
+        void begin( uint8_t maxColumns, uint8_t maxRows, charDotSize dotSize = charDotSize::size5x8 ) override {
+            // helper may be shared, frequency may have been set elsewhere
+            computeSettleTime( _wireHelper->getFrequency() );
+            LCD_HD44780::begin( maxColumns, maxRows, dotSize );
+        }
 
     //
     // USER COMMANDS
@@ -127,6 +140,15 @@ class LCD_i2c : public LCD_HD44780 {
     //
     public:
 
+        inline transportCost getTransportCost() override {
+            // command: 1 transmission of address + 4 bytes
+            // character within bulk write: 4 bytes
+            // plus padding on fast buses
+            if ( packetLimit == bytesPerChar )
+                return { (uint8_t) ( 1 + bytesPerChar ), (uint8_t) ( 1 + bytesPerChar ) };
+            return { (uint8_t) ( 1 + bytesPerChar ), bytesPerChar };
+        }
+
         inline void command( uint8_t value ) override {
             // RS = LOW
             send( value, 0 );
@@ -138,30 +160,91 @@ class LCD_i2c : public LCD_HD44780 {
             return 1;
         }
 
+        using LCD_HD44780::write;
+
+        size_t write( const uint8_t *buffer, size_t size ) override {
+            // RS = HIGH
+            // pack EN high/low of both nibbles of each character
+            // and send as few transmissions as possible
+            // time to send next bytes covers settling time of previous character
+            uint8_t packet[ packetLength ];
+            size_t sent = 0;
+            while( sent < size ) {
+                uint8_t length = 0;
+                while( sent < size && length + bytesPerChar <= packetLength && length < packetLimit ) {
+                    packChar( packet + length, buffer[sent++], PIN_RS );
+                    length += bytesPerChar;
+                }
+                if ( _wireHelper->writeBytes_i2c( _i2cAddress, packet, length ) != i2cHelper::ERR_I2C_OK )
+                    return sent - length / bytesPerChar;
+                if ( settleDelayInUs != 0 ) delayMicroseconds( settleDelayInUs );
+            }
+            return size;
+        }
+
     //
     // LOW LEVEL
     //
     private:
 
         void sendNibble( uint8_t nibble ) override {
-            // send lower nibble
-            sendCore( nibble << 4 );
+            // send lower nibble, EN high/low in 1 transmission
+            uint8_t value = ( nibble << 4 ) | _backlightStatus;
+            uint8_t packet[2] = { (uint8_t) ( value | PIN_EN ), value };
+            _wireHelper->writeBytes_i2c( _i2cAddress, packet, 2 );
+            if ( settleDelayInUs != 0 ) delayMicroseconds( settleDelayInUs );
         }
 
         void send( uint8_t value, uint8_t mode ) {
-            uint8_t hiNibble = value & 0xF0;
-            uint8_t loNibble = ( value << 4 ) & 0xF0;
-            sendCore( hiNibble | mode );
-            sendCore( loNibble | mode );
-        }
-
-        void sendCore( uint8_t value ) {
-            value |= _backlightStatus;
-            //expanderWrite( value );
-            expanderWrite( value | PIN_EN ); // EN high - send together
-            delayMicroseconds( 1 );          // enable pulse must be >450ns
-            expanderWrite( value );          // EN low
-            delayMicroseconds( 50 );         // commands need > 37us to settle
+            // both nibbles in 1 transmission, instead of 4
+            uint8_t packet[ 4 + PAD_MAX ];
+            packChar( packet, value, mode );
+            _wireHelper->writeBytes_i2c( _i2cAddress, packet, bytesPerChar );
+            if ( settleDelayInUs != 0 ) delayMicroseconds( settleDelayInUs );
+        }
+
+        // settling time comes from bus time instead of delays
+        // - EN pulse, 1 byte on the bus, is always > 450ns
+        // - next character latches 2 bytes after previous, or 3 if new transmission (start + address)
+        //   must be > 37us, at 100kHz/400kHz a byte takes 90us/22.5us so no padding or delay needed
+        // - faster buses repeat the EN low byte as padding, and delay after transmission
+        // - if padding is still too short, 1 character per transmission
+        // - frequency unknown (0): assume any speed, 1 character per transmission, padded, full delay
+        static const uint8_t PAD_MAX = 4;
+        static const uint8_t settleInUs = 37;
+        uint8_t bytesPerChar = 4 + PAD_MAX;
+        uint8_t settleDelayInUs = settleInUs;
+        uint8_t packetLimit = 4 + PAD_MAX;
+
+        void computeSettleTime( uint32_t frequency ) {
+            uint32_t kHz = frequency / 1000;
+            if ( kHz == 0 ) {
+                bytesPerChar = 4 + PAD_MAX;
+                packetLimit = bytesPerChar;
+                settleDelayInUs = settleInUs;
+                return;
+            }
+            uint32_t byteInNs = 9000000UL / kHz;    // 9 bits with ACK
+            uint8_t pad = 0;
+            while( pad < PAD_MAX && (uint32_t) ( 2 + pad ) * byteInNs < settleInUs * 1000UL ) pad++;
+            bytesPerChar = 4 + pad;
+            packetLimit = ( (uint32_t) ( 2 + pad ) * byteInNs < settleInUs * 1000UL ) ? bytesPerChar : packetLength;
+            uint32_t covered = 3UL * byteInNs / 1000;
+            settleDelayInUs = ( covered >= settleInUs ) ? 0 : settleInUs - covered;
+        }
+
+        // characters per transmission, 4 bytes each
+        static const uint8_t packetLength = ( i2cHelper::wireBufferLength < 64 ? i2cHelper::wireBufferLength : 64 ) & ~0x03;
+
+        inline void packChar( uint8_t *packet, uint8_t value, uint8_t mode ) {
+            uint8_t hiNibble = ( value & 0xF0 ) | mode | _backlightStatus;
+            uint8_t loNibble = ( ( value << 4 ) & 0xF0 ) | mode | _backlightStatus;
+            packet[0] = hiNibble | PIN_EN;   // EN high
+            packet[1] = hiNibble;            // EN low - latched
+            packet[2] = loNibble | PIN_EN;
+            packet[3] = loNibble;
+            for( uint8_t i = 4 ; i < bytesPerChar ; i++ )
+                packet[i] = loNibble;        // padding, nothing latched
         }
 
         inline void expanderWrite( uint8_t data ) {
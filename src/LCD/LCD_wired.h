@@ -29,6 +29,25 @@
 // #define LCD_READ_WRITE_MODE       // R/W pin of LCD is used, otherwise R/W pin is hardwired as write (low)
 // #define LCD_USE_8BIT_PORT         // handle 8 bit data mode
 // #define LCD_INCLUDE_READ_ROUTINES // even in read-only mode, include reading routines
+// #define LCD_NO_FAST_PORT          // always use digitalWrite(), no direct port writes
+//
+// Busy Flag (LCD_READ_WRITE_MODE only)
+//
+//      lcd.useBusyFlag();                  poll LCD instead of waiting worst case delays
+//      bool isUsingBusyFlag()              false if reverted to fixed delays
+//      uint32_t busyFlagTimeouts           number of times LCD stayed busy past worst case
+
+// direct port writes, masks computed at begin()
+// - AVR   : data pins on at most 2 ports
+// - ESP32 : data pins below 32
+// otherwise falls back to digitalWrite()
+#if !defined( LCD_NO_FAST_PORT ) && ( defined( ARDUINO_ARCH_AVR ) || defined( ESP32 ) )
+    #define LCD_WIRED_FAST_PORT
+    #if defined( ESP32 )
+        #include <soc/soc.h>
+        #include <soc/gpio_reg.h>
+    #endif
+#endif
 
 namespace StarterPack {
 
@@ -136,6 +155,22 @@ public:
         #endif
     #endif
 
+    void begin( uint8_t maxColumns, uint8_t maxRows, charDotSize dotSize = charDotSize::size5x8 ) override {
+        #if defined( LCD_WIRED_FAST_PORT )
+            initFastPort();
+        #endif
+        #if defined( LCD_READ_WRITE_MODE )
+            // busy flag is not valid until interface length is set
+            bool useBusy = busyFlagMode;
+            busyFlagMode = false;
+            pendingWaitInUs = 0;
+            LCD_HD44780::begin( maxColumns, maxRows, dotSize );
+            busyFlagMode = useBusy;
+        #else
+            LCD_HD44780::begin( maxColumns, maxRows, dotSize );
+        #endif
+    }
+
     inline void setTimeoutInMs( uint16_t timeOut ) override {}
     inline void setFrequency( uint32_t frequency ) override {}
 
@@ -192,34 +227,287 @@ public:
     //
     public:
 
+        inline transportCost getTransportCost() override {
+            // command and character both 1 byte with same settling time
+            return { 1, 1 };
+        }
+
         void command( uint8_t com ) override {
-            digitalWrite( LCD_RS, LOW );
-            setWriteMode();
-            setDataPortToWrite( true );
+            prepareSend( LOW );
             LCD_SEND_COMMAND( com );
-            delayMicroseconds( 37 );
+            afterSend();
         }
 
         size_t write( uint8_t ch ) override {
-            digitalWrite( LCD_RS, HIGH );
-            setWriteMode();
-            setDataPortToWrite( true );
+            prepareSend( HIGH );
             LCD_SEND_COMMAND( ch );
-            delayMicroseconds(37);
+            afterSend();
             return 1;
         }
 
+        using LCD_HD44780::write;
+
+        size_t write( const uint8_t *buffer, size_t size ) override {
+            // set RS/RW/port direction once for whole run
+            // unless busy flag was read in between
+            prepareSend( HIGH );
+            for( size_t i = 0 ; i < size ; i++ ) {
+                #if defined( LCD_READ_WRITE_MODE )
+                    if ( pendingWaitInUs != 0 ) prepareSend( HIGH );
+                #endif
+                LCD_SEND_COMMAND( buffer[i] );
+                afterSend();
+            }
+            return size;
+        }
+
+    protected:
+
+        void waitUntilReady( uint16_t worstCaseInUs ) override {
+            #if defined( LCD_READ_WRITE_MODE )
+                if ( busyFlagMode ) {
+                    // checked before next send
+                    pendingWaitInUs += worstCaseInUs;
+                    return;
+                }
+            #endif
+            delayMicroseconds( worstCaseInUs );
+        }
+
+    private:
+
+        inline void prepareSend( uint8_t rs ) {
+            #if defined( LCD_READ_WRITE_MODE )
+                if ( pendingWaitInUs != 0 ) waitWhileBusy();
+            #endif
+            digitalWrite( LCD_RS, rs );
+            setWriteMode();
+            setDataPortToWrite( true );
+        }
+
+        inline void afterSend() {
+            // command and character both need 37us
+            #if defined( LCD_READ_WRITE_MODE )
+                if ( busyFlagMode ) {
+                    lastSendInUs = micros();
+                    pendingWaitInUs = 37;
+                    return;
+                }
+            #endif
+            delayMicroseconds( 37 );
+        }
+
+    //
+    // BUSY FLAG
+    //
+    #if defined( LCD_READ_WRITE_MODE )
+
+    public:
+
+        // poll busy flag instead of waiting worst case delays
+        // - LCD usually finishes well before datasheet worst case
+        // - wait is done before next send, so caller can work in the meantime
+        // - if still busy after worst case, proceed anyway (same as fixed delay)
+        //   after busyFlagMaxTimeouts in a row, revert to fixed delays
+        //   ex. R/W not connected, DB7 floating high
+        void useBusyFlag( bool enable = true ) {
+            if ( pendingWaitInUs != 0 ) delayMicroseconds( pendingWaitInUs );
+            busyFlagMode = enable;
+            consecutiveTimeouts = 0;
+            pendingWaitInUs = 0;
+        }
+        inline bool isUsingBusyFlag() { return busyFlagMode; }
+
+        uint32_t busyFlagTimeouts = 0;
+        static const uint8_t busyFlagMaxTimeouts = 3;
+
+        uint8_t readStatus() {
+            // busy flag (bit 7) and address counter (bits 0-6)
+            digitalWrite( LCD_RS, LOW );
+            return LCD_readCore();
+        }
+
+    private:
+
+        bool busyFlagMode = false;
+        uint8_t consecutiveTimeouts = 0;
+        uint16_t pendingWaitInUs = 0;   // worst case for last send, 0 if nothing pending
+        uint32_t lastSendInUs = 0;
+
+        void waitWhileBusy() {
+            // timeout only if still busy when read after worst case has passed
+            // reading takes a few us, LCD may finish while it is being read
+            while( true ) {
+                bool expired = ( micros() - lastSendInUs >= pendingWaitInUs );
+                if ( !LCD_isBusy() ) break;
+                if ( expired ) {
+                    // waited worst case, assume done
+                    busyFlagTimeouts++;
+                    if ( ++consecutiveTimeouts >= busyFlagMaxTimeouts )
+                        busyFlagMode = false;
+                    pendingWaitInUs = 0;
+                    return;
+                }
+            }
+            consecutiveTimeouts = 0;
+            pendingWaitInUs = 0;
+        }
+
+    #endif
+
+    //
+    // FAST PORT
+    //
+    #if defined( LCD_WIRED_FAST_PORT )
+
+    private:
+
+        // nibble tables, bits to set for each nibble value
+        // - lo : DB0-DB3 (8-bit mode only)
+        // - hi : DB4-DB7
+        #if defined( ARDUINO_ARCH_AVR )
+            typedef uint8_t fastBits;
+            struct fastPort {
+                volatile uint8_t *out;
+                uint8_t mask;           // all data pins on this port
+                #if defined( LCD_USE_8BIT_PORT )
+                    uint8_t lo[16];
+                #endif
+                uint8_t hi[16];
+            };
+            static const uint8_t FAST_PORT_MAX = 2;
+            fastPort fastPorts[ FAST_PORT_MAX ];
+            uint8_t fastPortCount = 0;  // 0 if digitalWrite() is used
+            volatile uint8_t *fastE_out = nullptr;
+        #else
+            typedef uint32_t fastBits;
+            struct fastPort {
+                uint32_t mask;
+                #if defined( LCD_USE_8BIT_PORT )
+                    uint32_t lo[16];
+                #endif
+                uint32_t hi[16];
+            };
+            static const uint8_t FAST_PORT_MAX = 1;
+            fastPort fastPorts[ FAST_PORT_MAX ];
+            uint8_t fastPortCount = 0;
+        #endif
+        fastBits fastE_mask = 0;
+
+        bool fastPinLookup( uint8_t pin, uint8_t &portIndex, fastBits &bit ) {
+            // find or add port of pin
+            #if defined( ARDUINO_ARCH_AVR )
+                uint8_t port = digitalPinToPort( pin );
+                if ( port == NOT_A_PIN ) return false;
+                volatile uint8_t *out = portOutputRegister( port );
+                bit = digitalPinToBitMask( pin );
+                for( portIndex = 0 ; portIndex < fastPortCount ; portIndex++ )
+                    if ( fastPorts[portIndex].out == out ) return true;
+                if ( fastPortCount >= FAST_PORT_MAX ) return false;
+                portIndex = fastPortCount++;
+                memset( &fastPorts[portIndex], 0, sizeof( fastPort ) );
+                fastPorts[portIndex].out = out;
+                return true;
+            #else
+                if ( pin >= 32 ) return false;
+                bit = (uint32_t) 1 << pin;
+                if ( fastPortCount == 0 ) {
+                    fastPortCount = 1;
+                    memset( &fastPorts[0], 0, sizeof( fastPort ) );
+                }
+                portIndex = 0;
+                return true;
+            #endif
+        }
+
+        bool fastAddNibble( const uint8_t *pins, bool high ) {
+            for( uint8_t b = 0 ; b < 4 ; b++ ) {
+                uint8_t portIndex; fastBits bit;
+                if ( !fastPinLookup( pins[b], portIndex, bit ) ) return false;
+                fastPort &fp = fastPorts[portIndex];
+                fp.mask |= bit;
+                for( uint8_t v = 0 ; v < 16 ; v++ ) {
+                    if ( ( v & ( 1 << b ) ) == 0 ) continue;
+                    #if defined( LCD_USE_8BIT_PORT )
+                        if ( !high ) { fp.lo[v] |= bit; continue; }
+                    #endif
+                    fp.hi[v] |= bit;
+                }
+            }
+            return true;
+        }
+
+        void initFastPort() {
+            fastPortCount = 0;
+            #if defined( LCD_USE_8BIT_PORT )
+                uint8_t lo[4] = { LCD_DB0, LCD_DB1, LCD_DB2, LCD_DB3 };
+                if ( !fastAddNibble( lo, false ) ) { fastPortCount = 0; return; }
+            #endif
+            uint8_t hi[4] = { LCD_DB4, LCD_DB5, LCD_DB6, LCD_DB7 };
+            if ( !fastAddNibble( hi, true ) ) { fastPortCount = 0; return; }
+            #if defined( ARDUINO_ARCH_AVR )
+                uint8_t port = digitalPinToPort( LCD_E );
+                if ( port == NOT_A_PIN ) { fastPortCount = 0; return; }
+                fastE_out  = portOutputRegister( port );
+                fastE_mask = digitalPinToBitMask( LCD_E );
+            #else
+                if ( LCD_E >= 32 ) { fastPortCount = 0; return; }
+                fastE_mask = (uint32_t) 1 << LCD_E;
+            #endif
+        }
+
+        inline void fastPortWrite( fastPort &fp, fastBits bits ) {
+            // other pins on the same port are left alone
+            #if defined( ARDUINO_ARCH_AVR )
+                uint8_t sreg = SREG; cli();
+                *fp.out = ( *fp.out & ~fp.mask ) | bits;
+                SREG = sreg;
+            #else
+                REG_WRITE( GPIO_OUT_W1TS_REG, bits );
+                REG_WRITE( GPIO_OUT_W1TC_REG, fp.mask & ~bits );
+            #endif
+        }
+
+        inline void fastEnable( bool high ) {
+            #if defined( ARDUINO_ARCH_AVR )
+                uint8_t sreg = SREG; cli();
+                if ( high ) *fastE_out |= fastE_mask; else *fastE_out &= ~fastE_mask;
+                SREG = sreg;
+            #else
+                REG_WRITE( high ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, fastE_mask );
+            #endif
+        }
+
+    #endif
+
     //
     // LOW LEVEL
     //
     private:
 
+        inline void setEnable( bool high ) {
+            #if defined( LCD_WIRED_FAST_PORT )
+                if ( fastPortCount != 0 ) { fastEnable( high ); return; }
+            #endif
+            digitalWrite( LCD_E, high ? HIGH : LOW );
+        }
+
+        inline void readStart() {
+            // read - delay time 360ns
+            setEnable( true );
+            delayMicroseconds( 1 );
+        }
+        inline void readEnd() {
+            setEnable( false );
+            delayMicroseconds( 1 );
+        }
+
         inline void pulse() {
             // https://html.alldatasheet.com/html-pdf/63673/HITACHI/HD44780/12294/49/HD44780.html
-            digitalWrite( LCD_E, HIGH );
+            setEnable( true );
             // pulse width - 450ns
             delayMicroseconds( 1 );
-            digitalWrite( LCD_E, LOW );
+            setEnable( false );
             // write - setup time 195ns
             // read  - delay time 360ns
             delayMicroseconds( 1 );
@@ -228,7 +516,16 @@ public:
         #if defined( LCD_USE_8BIT_PORT )
 
             void LCD_SEND_COMMAND( uint8_t ch ) {
-                // easier to convert to fastDigitalWrite()
+                #if defined( LCD_WIRED_FAST_PORT )
+                    if ( fastPortCount != 0 ) {
+                        for( uint8_t i = 0 ; i < fastPortCount ; i++ ) {
+                            fastPort &fp = fastPorts[i];
+                            fastPortWrite( fp, fp.lo[ ch & 0x0F ] | fp.hi[ ch >> 4 ] );
+                        }
+                        pulse();
+                        return;
+                    }
+                #endif
                 // digitalWrite( LCD_E, HIGH );
                 // PORTB = ch;
                 // assume HIGH==1, LOW==0
@@ -256,7 +553,14 @@ public:
             }
 
             void LCD_putNibble( uint8_t ch ) {
-                // easier to convert to fastDigitalWrite()
+                #if defined( LCD_WIRED_FAST_PORT )
+                    if ( fastPortCount != 0 ) {
+                        ch &= 0x0F;
+                        for( uint8_t i = 0 ; i < fastPortCount ; i++ )
+                            fastPortWrite( fastPorts[i], fastPorts[i].hi[ch] );
+                        return;
+                    }
+                #endif
                 // assume HIGH==1, LOW==0
                 digitalWrite( LCD_DB4, ch & 1 ); ch >>= 1;
                 digitalWrite( LCD_DB5, ch & 1 ); ch >>= 1;
@@ -287,7 +591,7 @@ public:
     // READ ROUTINES
     //
     
-        #if defined( LCD_READ_WRITE_MODE ) && defined( LCD_INCLUDE_READ_ROUTINES )
+        #if defined( LCD_READ_WRITE_MODE )
         
             uint8_t LCD_readCore() {
                 
@@ -295,12 +599,11 @@ public:
                 setReadMode();
                 setDataPortToWrite( false );
 
+                // data is only valid while E is high
+                // https://html.alldatasheet.com/html-pdf/63673/HITACHI/HD44780/12294/49/HD44780.html
                 uint8_t result = 0;
                 #if defined( LCD_USE_8BIT_PORT )
-                    // digitalWrite( LCD_E, HIGH );
-                    // digitalWrite( LCD_E, LOW );
-                    pulse();
-                    // delay here ???
+                    readStart();
                     // result = PORTB;
                     if ( digitalRead( LCD_DB7 ) ) result |= 1; result <<= 1;
                     if ( digitalRead( LCD_DB6 ) ) result |= 1; result <<= 1;
@@ -310,23 +613,20 @@ public:
                     if ( digitalRead( LCD_DB2 ) ) result |= 1; result <<= 1;
                     if ( digitalRead( LCD_DB1 ) ) result |= 1; result <<= 1;
                     if ( digitalRead( LCD_DB0 ) ) result |= 1;
+                    readEnd();
                 #else                                    
-                    // digitalWrite( LCD_E, HIGH );
-                    // digitalWrite( LCD_E, LOW );
-                    pulse();
-                    // delay here ???
+                    readStart();
                     if ( digitalRead( LCD_DB7 ) ) result |= 1; result <<= 1;
                     if ( digitalRead( LCD_DB6 ) ) result |= 1; result <<= 1;
                     if ( digitalRead( LCD_DB5 ) ) result |= 1; result <<= 1;
                     if ( digitalRead( LCD_DB4 ) ) result |= 1; result <<= 1;
-                    // digitalWrite( LCD_E, HIGH );
-                    // digitalWrite( LCD_E, LOW );
-                    pulse();
-                    // delay here ???
+                    readEnd();
+                    readStart();
                     if ( digitalRead( LCD_DB7 ) ) result |= 1; result <<= 1;
                     if ( digitalRead( LCD_DB6 ) ) result |= 1; result <<= 1;
                     if ( digitalRead( LCD_DB5 ) ) result |= 1; result <<= 1;
                     if ( digitalRead( LCD_DB4 ) ) result |= 1;                        
+                    readEnd();
                 #endif
                 return result;
             }
@@ -339,6 +639,10 @@ public:
                 return ( result & 0b10000000 ) != 0;
             }
 
+        #endif
+
+        #if defined( LCD_READ_WRITE_MODE ) && defined( LCD_INCLUDE_READ_ROUTINES )
+
             // https://html.alldatasheet.com/html-pdf/63673/HITACHI/HD44780/7776/31/HD44780.html
 
             uint8_t LCD_readCGRAM( uint8_t addr ) {
@@ -3,7 +3,6 @@
 
 #include <LCD/LCDInterface.h>
 // #include <spUtility.h>
-#include <Utility/spVector.h>
 
 // #define DEBUG_DIAGNOSE
 // #define DBG_SPC "<charbank> "
@@ -34,21 +33,33 @@ class LCDCharBank {
     //     cBank.addtoDb( 10, bitmap );
     //     cBank.loadChars( 5, 10 ); // bitmap loaded to position 5
     //     LCD.write( 5 );           // must write slot used to LCD screen
+    //
+    // Style 3: automatic, more than 8 characters over time
+    //     cBank.autoLoad = true;
+    //     cBank.addtoDb( 10, bitmap ); ... cBank.addToDb( 30, bitmap );
+    //     cBank.write( 10 );            // loaded into free slot, or slot least recently used
+    //                                   // slots still on screen are kept (buffered LCD only)
+    //                                   // not uploaded again if same bitmap already loaded
+    //     cBank.invalidate();           // after LCD reset/recovery, CGRAM is lost
+    //
+    // loadChars() and loadCharsToSlot0() always upload, use them to restore glyphs after LCD reset
 
     protected:
 
-        struct data {
-            uint8_t dbID;
-            const uint8_t * charmap;
-        };
-        spVector<data> head;
-
         StarterPack::LCDInterface * lcd = nullptr;
 
-        // dbID of characters loaded into LCD hardware
+        // bitmaps by dbID, grown as needed
+        const uint8_t ** dbIndex = nullptr;
+        uint16_t dbIndexSize = 0;
+
+        // bitmaps loaded into LCD hardware
         // max 8 slot in LCD buffer
         static constexpr uint8_t LCD_BITMAP_BUFFER_COUNT = 8;
-        int8_t charMap[LCD_BITMAP_BUFFER_COUNT] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+        const uint8_t * slotBitmap[LCD_BITMAP_BUFFER_COUNT] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+
+        // for least recently used, ticks wrap around
+        uint16_t slotLastUsed[LCD_BITMAP_BUFFER_COUNT] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        uint16_t useTick = 0;
 
     public:
 
@@ -56,20 +67,34 @@ class LCDCharBank {
 
         LCDCharBank( StarterPack::LCDInterface * lcd ) { this->lcd = lcd; }
 
+        ~LCDCharBank() {
+            if ( dbIndex != nullptr ) delete[] dbIndex;
+        }
+
+        // load on write( dbID ) if not yet loaded
+        bool autoLoad = false;
+
+        // createChar() sent / skipped since bitmap already loaded
+        uint16_t uploads = 0;
+        uint16_t uploadsSkipped = 0;
+
         void addToDb( uint8_t dbID, const uint8_t charmap[] ) {
             // add bitmap to databank
-            auto d = new data();
-            d->dbID = dbID;
-            d->charmap = &(charmap[0]);
-            head.insert( d );
+            if ( dbID >= dbIndexSize ) {
+                uint16_t newSize = dbID + 1;
+                auto newIndex = new const uint8_t *[newSize];
+                for( uint16_t i = 0 ; i < newSize ; i++ )
+                    newIndex[i] = ( i < dbIndexSize ) ? dbIndex[i] : nullptr;
+                if ( dbIndex != nullptr ) delete[] dbIndex;
+                dbIndex = newIndex;
+                dbIndexSize = newSize;
+            }
+            dbIndex[dbID] = &(charmap[0]);
         }
 
-        void addToDb( uint8_t dbID, const char * charmap ) {
+        inline void addToDb( uint8_t dbID, const char * charmap ) {
             // add bitmap to databank
-            auto d = new data();
-            d->dbID = dbID;
-            d->charmap = (const uint8_t *) charmap;
-            head.insert( d );
+            addToDb( dbID, (const uint8_t *) charmap );
         }
 
     public:
@@ -97,11 +122,10 @@ class LCDCharBank {
 
         inline bool loadCharCore( int dbID, int & charSlot ) {
             // if ( lcd == nullptr ) return false;
-            data * p = find( dbID );
+            const uint8_t * p = find( dbID );
             if ( p != nullptr ) {
                 if ( charSlot >= LCD_BITMAP_BUFFER_COUNT ) charSlot = 0; // 0 to 7 only
-                charMap[charSlot] = dbID;
-                lcd->createChar( charSlot, p->charmap );
+                loadSlot( charSlot, p, true );
                 _DBG( "slot " ); DBG( charSlot ); DBG( " = " ); DBG_( dbID );
                 charSlot++;
                 return true;
@@ -109,6 +133,46 @@ class LCDCharBank {
             return false;
         }
 
+        void loadSlot( uint8_t charSlot, const uint8_t * bitmap, bool force = false ) {
+            // upload only if different from what is already in slot, unless forced
+            slotLastUsed[charSlot] = ++useTick;
+            if ( !force && sameBitmap( slotBitmap[charSlot], bitmap ) ) {
+                slotBitmap[charSlot] = bitmap;
+                uploadsSkipped++;
+                return;
+            }
+            slotBitmap[charSlot] = bitmap;
+            lcd->createChar( charSlot, bitmap );
+            uploads++;
+        }
+
+        static bool sameBitmap( const uint8_t * a, const uint8_t * b ) {
+            if ( a == b ) return true;
+            if ( a == nullptr || b == nullptr ) return false;
+            return memcmp( a, b, 8 ) == 0;
+        }
+
+        int8_t assignSlot( uint8_t dbID ) {
+            // load into free slot, or least recently used slot not on screen
+            const uint8_t * bitmap = find( dbID );
+            if ( bitmap == nullptr ) return -1;
+            int8_t victim = -1;
+            uint16_t oldest = 0;
+            for( uint8_t i = 0 ; i < LCD_BITMAP_BUFFER_COUNT ; i++ ) {
+                if ( slotBitmap[i] == nullptr ) { victim = i; break; }
+                if ( lcd->isCharCodeInUse( i ) ) continue;
+                uint16_t age = useTick - slotLastUsed[i];
+                if ( victim == -1 || age > oldest ) {
+                    victim = i;
+                    oldest = age;
+                }
+            }
+            if ( victim == -1 ) return -1;  // all 8 on screen
+            loadSlot( victim, bitmap );
+            _DBG( "auto slot " ); DBG( victim ); DBG( " = " ); DBG_( dbID );
+            return victim;
+        }
+
         bool loadN( int charSlot, int argCount, ... ) {
             // load N chars into LCD, with starting index
             // ex. loadN( 6, 2, A, B )
@@ -131,21 +195,19 @@ class LCDCharBank {
 
     protected:
 
-        data * find( uint8_t dbID ) {
+        inline const uint8_t * find( uint8_t dbID ) {
             // return bitmap of character
-            data * p = head.getFirst();
-            while( p != nullptr ) {
-                if ( p->dbID == dbID )
-                    return p;
-                p = head.getNext();
-            }
-            return nullptr;
+            if ( dbID >= dbIndexSize ) return nullptr;
+            return dbIndex[dbID];
         }
 
         int8_t findLoadedSlot( uint8_t dbID ) {
-            // return true if char is loaded
+            // return slot where bitmap is loaded, -1 if not loaded
+            // different dbID with same bitmap shares the slot
+            const uint8_t * bitmap = find( dbID );
+            if ( bitmap == nullptr ) return -1;
             for( int i=0 ; i<LCD_BITMAP_BUFFER_COUNT ; i++ ) {
-                if ( charMap[i] == dbID )
+                if ( sameBitmap( slotBitmap[i], bitmap ) )
                     return i;
             }
             return -1;
@@ -158,15 +220,34 @@ class LCDCharBank {
             return ( find( dbID ) != nullptr );
         }
 
+        void invalidate() {
+            // LCD was reset, slots no longer hold the bitmaps
+            // autoLoad uploads again on next write()
+            for( uint8_t i = 0 ; i < LCD_BITMAP_BUFFER_COUNT ; i++ )
+                slotBitmap[i] = nullptr;
+        }
+
         bool isLoaded( uint8_t dbID ) {
             // return true if char is loaded into LCD screen
             return ( findLoadedSlot( dbID ) != -1 );
         }
 
+        int8_t getCharCode( uint8_t dbID ) {
+            // character code to write to LCD, -1 if not loaded
+            // loaded first if autoLoad
+            if ( lcd == nullptr ) return -1;
+            auto p = findLoadedSlot( dbID );
+            if ( p != -1 )
+                slotLastUsed[p] = ++useTick;
+            else if ( autoLoad )
+                p = assignSlot( dbID );
+            return p;
+        }
+
         void write( uint8_t dbID ) {
             // write character to LCD at current cursor position, if loaded
             if ( lcd == nullptr ) return;
-            auto p = findLoadedSlot( dbID );
+            auto p = getCharCode( dbID );
             if ( p == -1 )
                 lcd->write( ' ' );
             else
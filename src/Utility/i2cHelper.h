@@ -31,11 +31,13 @@
 //
 //      void     setTimeoutInMs( value )    sets i2c timeout, default is 50 ms
 //      void     setFrequency( value )      sets i2c speed, default is based on Wire.h
+//      uint32_t getFrequency()             as set thru setFrequency(), 0 if not set
 //      bool     verify()                   verify i2c connection, returns true/false
 //      ERROR_NO verifyWithError()          verify i2c connection, returns error number
 //      char *   errorMessage( ERROR_NO )   return error message string
-//      bool     recoverIfHasError()        resets i2c if error has been found, return true if recovery attempt was made
-//      uint16_t recoveryThrottleInMs       time between recovery attempts, default 2000 ms
+//      bool     recoverIfHasError()        resets i2c if error has been found, return true if device should be re-initialized
+//                                          clears bus first if pins are set, see Recovery
+//      uint16_t recoveryThrottleInMs       longest time between retries of a device, default 2000 ms
 //      ERROR_NO lastError                  last error detected, will not reset even if next calls succeeds
 //                                          resets only upon calling recoverIfHasError(), clearLastError() or directly cleared
 //      void     clearLastError()           clear lastError
@@ -62,6 +64,8 @@
 //      ex. uint16_t result = i2cHelper.readTwoBytes_DiffAddr( addr1, addr2 );
 //          if ( i2cHelper.lastError != ERR_I2C_OK ) ... error found
 //
+//      one read per register, for consecutive registers of auto-increment devices readBytes() is 1 request
+//
 //  Read 2 Bytes from Same Address (ex. AS5600 magnetic encoder)
 //
 //      ERROR_NO readTwoBytes_SameAddr_HiLo( dataAddr, & result )
@@ -75,6 +79,87 @@
 //      ex. uint16_t result = i2cHelper.readTwoBytes_SameAddr_LoHi( addr );
 //          if ( i2cHelper.lastError != ERR_I2C_OK ) ... error found
 //
+//  Read Consecutive Registers (ex. IMU, RTC)
+//
+//      ERROR_NO readBytes( dataAddr, buffer[], length )
+//      ex. uint8_t sample[6];
+//          ERROR_NO err = i2cHelper.readBytes( 0x3B, sample, 6 );
+//          if ( err != ERR_I2C_OK ) ... error found
+//
+//      register address is sent once, bytes are read in one request
+//      longer than wire buffer is read with more requests, device continues from where it stopped
+//
+//  Write
+//
+//      ERROR_NO writeOneByte( data )
+//      ERROR_NO writeAddrAndData( dataAddr, dataValue )
+//      ERROR_NO writeBytes( data[], length )      send all in one transmission, split if longer than wire buffer
+//      ERROR_NO writeAddrAndBytes( dataAddr, data[], length )
+//                                                 register address followed by data in one transmission
+//                                                 if split, each part restarts at dataAddr + bytes already sent
+//
+//  Recovery
+//
+//      void setBusPins( sda, scl )         pins of this bus, enables clearing of bus on recovery
+//                                          a device stuck holding SDA low is clocked out with up to 9 SCL pulses + STOP
+//      uint16_t recoveryMinDelayInMs       first retry after an error, default 10 ms
+//                                          doubles after each failed retry up to recoveryThrottleInMs, plus random 0-25%
+//      uint16_t busClears                  number of times bus was cleared
+//
+//      device with errors is offline until its retry time, calls to it fail at once with ERR_I2C_OFFLINE
+//      without using the bus, so other devices on same bus are not slowed down
+//      first successful transfer after retry time brings it back online
+//      recoverIfHasError() resets the bus once after each failed attempt
+//      but returns true only once device takes transfers again (due for retry or back online)
+//      so re-init done by caller on true is sent, not failed with ERR_I2C_OFFLINE
+//      offline devices are retried when due even if recoverIfHasError() is never called
+//      devices not tracked (more than SP_I2CHELPER_MAX_DEVICES) recover every recoveryThrottleInMs as before
+//
+//  Device Health (per address, up to SP_I2CHELPER_MAX_DEVICES, default 4, 2 on AVR)
+//
+//      deviceHealth *getDeviceHealth( i2cAddress )   nullptr if no errors yet
+//      uint8_t getDeviceHealthCount(), deviceHealth &getDeviceHealthAt( index )
+//      void resetDeviceHealth()
+//
+//      deviceHealth: errorCount( ERROR_NO ), recoveries, skipped (calls while offline),
+//                    isOffline(), getOfflineTimeInMs() (total, including current)
+//
+//  Shadow Registers
+//
+//      last value written is kept, writing the same value again is skipped
+//      only for registers that are not changed by the device itself (ex. configuration)
+//
+//      i2cHelper::shadowRegisters<8> gpio( 0x20, 0x00 );  // device 0x20, registers 0x00-0x07
+//      i2cHelper::shadowRegisters<1> port( 0x27 );        // device without registers, ex. PCF8574
+//      i2cHelper.attachShadow( gpio );
+//      i2cHelper.attachShadow( port );
+//
+//      ERROR_NO setBits( dataAddr, mask )                 read-modify-write, read from shadow if known
+//      ERROR_NO clearBits( dataAddr, mask )
+//      ERROR_NO updateBits( dataAddr, mask, value )
+//      void     invalidateShadow()                        forget all, done by recoverIfHasError()
+//      uint32_t shadowHits, shadowMisses                  writes skipped / sent
+//
+//      writeAddrAndData(), writeAddrAndBytes()            use register shadow
+//      writeOneByte(), writeBytes()                       use device shadow, writeBytes() only records last byte
+//
+//  Trace (define SP_I2CHELPER_TRACE as number of entries before including, ex. 64)
+//
+//      each transfer is recorded, oldest are overwritten
+//      start and duration in us, address, read/write, length, first 4 bytes, ERROR_NO
+//      not defined: nothing is recorded and no memory used, 20 bytes per entry if defined (17 on AVR)
+//
+//      bool     traceEnabled               pause/resume recording, default true
+//      void     clearTrace()
+//      uint16_t getTraceCount()            entries held
+//      traceEntry &getTraceAt( index )     0 is oldest
+//      uint32_t traceTotal                 recorded since clearTrace(), more than held if overwritten
+//      void     dumpTrace( Serial )        binary dump, decode with extras/i2cTrace/i2cTraceDecode.py
+//
+//  Non-Blocking
+//
+//      see i2cQueue.h, transactions are queued and sent by poll() or a background task
+//
 //  Ex:
 //      TwoWireHelper i2cHelper = TwoWireHelper( 0x36 )
 //      i2cHelper.recoveryThrottleInMs = 3000; // recover after every 3 seconds only
@@ -118,8 +203,12 @@ namespace StarterPack {
 
 typedef uint8_t ERROR_NO;
 
+class i2cQueue;
+
 class i2cHelper {
 
+        friend class i2cQueue;
+
     public:
 
         //
@@ -176,6 +265,7 @@ class i2cHelper {
         static const ERROR_NO ERR_I2C_ENDTRANS = 102;
         static const ERROR_NO ERR_I2C_REQUEST  = 103;
         static const ERROR_NO ERR_I2C_TIMEOUT2 = 104;
+        static const ERROR_NO ERR_I2C_OFFLINE  = 105;  // not sent, device is waiting to be retried
 
         static const char * errorMessage( ERROR_NO errorNo ) {
             switch ( errorNo ) {
@@ -189,14 +279,30 @@ class i2cHelper {
             case ERR_I2C_ENDTRANS:  return "invalid return value from endTransmission()";
             case ERR_I2C_REQUEST:   return "invalid requestFrom() length";
             case ERR_I2C_TIMEOUT2:  return "uncaught timeout";
+            case ERR_I2C_OFFLINE:   return "device offline, waiting to retry";
             default:                return "unknown error";
             }
         }
 
+    //
+    // WIRE BUFFER
+    //
+    public:
+
+        // bytes that fit in one transmission, longer writes are split
+        #if defined(I2C_BUFFER_LENGTH)
+            static const uint16_t wireBufferLength = I2C_BUFFER_LENGTH; // ESP32
+        #elif defined(BUFFER_LENGTH)
+            static const uint16_t wireBufferLength = BUFFER_LENGTH;     // AVR
+        #else
+            static const uint16_t wireBufferLength = 32;
+        #endif
+
     private:
 
         TwoWire * _wire;
         uint8_t   _defaultI2cAddress;
+        uint32_t  _frequency = 0;       // 0 if not set thru setFrequency()
 
     public:
 
@@ -321,8 +427,11 @@ class i2cHelper {
         }
 
         inline void setFrequency( uint32_t frequency ) {
+            _frequency = frequency;
             _wire->setClock( frequency );
         }
+
+        inline uint32_t getFrequency() { return _frequency; }
         
     //
     // LAST ERROR
@@ -335,15 +444,40 @@ class i2cHelper {
         
     private:
     
-        inline void RecordError( ERROR_NO newError ) {
+        void RecordError( ERROR_NO newError ) {
             lastError = newError;
+            traceEnd( newError );
+            // device goes offline until retry time, retry time doubles if already offline
+            deviceHealth *d = currentDevice != nullptr ? currentDevice : findDevice( currentAddress, true );
+            lastErrorDevice = d;
+            if ( d == nullptr ) return;
+            d->errors[ errorSlot( newError ) ]++;
+            uint32_t now = millis();
+            if ( !d->offline ) {
+                d->offline = true;
+                d->offlineSince = now;
+                d->backoffInMs = recoveryMinDelayInMs;
+            } else {
+                uint32_t next = (uint32_t) d->backoffInMs * 2;
+                d->backoffInMs = next > recoveryThrottleInMs ? recoveryThrottleInMs : next;
+            }
+            // jitter so devices/boards do not retry in step
+            d->nextAttempt = now + d->backoffInMs + random( d->backoffInMs / 4 + 1 );
+            currentDevice = d;
+        }
+
+        inline void RecordSuccess() {
+            traceEnd( ERR_I2C_OK );
+            if ( currentDevice == nullptr || !currentDevice->offline ) return;
+            currentDevice->offline = false;
+            currentDevice->offlineInMs += millis() - currentDevice->offlineSince;
         }
 
         #if defined(ARDUINO_ARCH_AVR)
         
             inline bool CheckAndRecordError() {
                 if ( _wire->getWireTimeoutFlag() ) {
-                    lastError = ERR_I2C_TIMEOUT;
+                    RecordError( ERR_I2C_TIMEOUT );
                     return false;
                 } else
                     return true;
@@ -375,11 +509,99 @@ class i2cHelper {
         }
 
         ERROR_NO verifyWithError( uint8_t _i2cAddress ) {
-            _wire->beginTransmission( _i2cAddress );
+            if ( !beginTransmission( _i2cAddress ) ) return ERR_I2C_OFFLINE;
             if ( !endTransmission() ) return lastError;
             return ERR_I2C_OK;
         }
 
+    //
+    // DEVICE HEALTH
+    //
+    public:
+
+        // ERR_I2C_BUFFER..ERR_I2C_TIMEOUT, ERR_I2C_WRITE..ERR_I2C_TIMEOUT2, others
+        static const uint8_t errorSlots = 10;
+
+        static uint8_t errorSlot( ERROR_NO errorNo ) {
+            if ( errorNo >= ERR_I2C_BUFFER && errorNo <= ERR_I2C_TIMEOUT ) return errorNo - ERR_I2C_BUFFER;
+            if ( errorNo >= ERR_I2C_WRITE && errorNo <= ERR_I2C_TIMEOUT2 ) return errorNo - ERR_I2C_WRITE + 5;
+            return errorSlots - 1;
+        }
+
+        struct deviceHealth {
+            uint8_t  i2cAddress;
+            bool     offline;
+            uint16_t errors[ errorSlots ];
+            uint16_t recoveries;        // recoverIfHasError() attempts for this device
+            uint32_t skipped;           // calls failed with ERR_I2C_OFFLINE
+            uint16_t backoffInMs;
+            uint32_t offlineSince;
+            uint32_t nextAttempt;
+            uint32_t offlineInMs;       // completed offline periods
+
+            inline uint16_t errorCount( ERROR_NO errorNo ) { return errors[ errorSlot( errorNo ) ]; }
+            inline bool isOffline() { return offline; }
+            inline uint32_t getOfflineTimeInMs() {
+                return offlineInMs + ( offline ? millis() - offlineSince : 0 );
+            }
+        };
+
+        #if defined(SP_I2CHELPER_MAX_DEVICES)
+            static const uint8_t maxDevices = SP_I2CHELPER_MAX_DEVICES;
+        #elif defined(ARDUINO_ARCH_AVR)
+            static const uint8_t maxDevices = 2;
+        #else
+            static const uint8_t maxDevices = 4;
+        #endif
+
+        inline deviceHealth *getDeviceHealth( uint8_t _i2cAddress ) { return findDevice( _i2cAddress, false ); }
+        inline uint8_t getDeviceHealthCount() { return deviceCount; }
+        inline deviceHealth &getDeviceHealthAt( uint8_t index ) { return devices[ index ]; }
+
+        void resetDeviceHealth() {
+            deviceCount = 0;
+            currentDevice = nullptr;
+            lastErrorDevice = nullptr;
+            recoveredDevice = nullptr;
+        }
+
+    private:
+
+        // added on first error, devices without errors are not tracked
+        deviceHealth devices[ maxDevices ];
+        uint8_t deviceCount = 0;
+
+        deviceHealth *currentDevice = nullptr;      // of current transfer, nullptr if not tracked
+        deviceHealth *lastErrorDevice = nullptr;
+        uint8_t currentAddress = 0;
+
+        deviceHealth *findDevice( uint8_t _i2cAddress, bool add ) {
+            for( uint8_t i = 0 ; i < deviceCount ; i++ ) {
+                if ( devices[i].i2cAddress == _i2cAddress ) return &devices[i];
+            }
+            if ( !add || deviceCount >= maxDevices ) return nullptr;
+            deviceHealth *d = &devices[ deviceCount++ ];
+            memset( d, 0, sizeof( deviceHealth ) );
+            d->i2cAddress = _i2cAddress;
+            return d;
+        }
+
+        inline bool isDue( deviceHealth *d ) {
+            return (int32_t) ( millis() - d->nextAttempt ) >= 0;
+        }
+
+        bool isDeviceReady( uint8_t _i2cAddress ) {
+            // offline device fails at once until its retry time
+            currentAddress = _i2cAddress;
+            currentDevice = deviceCount == 0 ? nullptr : findDevice( _i2cAddress, false );
+            if ( currentDevice == nullptr || !currentDevice->offline ) return true;
+            if ( isDue( currentDevice ) ) return true;
+            currentDevice->skipped++;
+            // keep error that made it offline for recoverIfHasError()
+            if ( lastError == ERR_I2C_OK ) lastError = ERR_I2C_OFFLINE;
+            return false;
+        }
+
     //
     // RECOVERY
     //
@@ -387,90 +609,424 @@ class i2cHelper {
 
         uint32_t lastRecovery = millis();
 
+        // bus was reset, caller not yet told to re-init
+        bool          recoveryPending = false;
+        deviceHealth *recoveredDevice = nullptr;    // nullptr if not tracked
+
+        uint8_t sdaPin = 0xFF;
+        uint8_t sclPin = 0xFF;
+
     public:
 
         uint16_t recoveryThrottleInMs = 2000;
+        uint16_t recoveryMinDelayInMs = 10;
+        uint16_t busClears = 0;
+
+        inline void setBusPins( uint8_t sda, uint8_t scl ) {
+            sdaPin = sda;
+            sclPin = scl;
+        }
+
+        bool recoverIfHasError( uint8_t _i2cAddress ) {
+            // nothing was sent if offline, device is retried when due
+            if ( lastError == ERR_I2C_OFFLINE ) lastError = ERR_I2C_OK;
+            if ( lastError != ERR_I2C_OK && !resetBusAfterError( _i2cAddress ) ) return false;
+            if ( !recoveryPending ) return false;
+            // caller re-inits on true, wait until device takes transfers again
+            if ( recoveredDevice != nullptr && recoveredDevice->offline && !isDue( recoveredDevice ) ) return false;
+            recoveryPending = false;
+            recoveredDevice = nullptr;
+            return true;
+        }
+
+        inline bool recoverIfHasError() {
+            return recoverIfHasError( _defaultI2cAddress );
+        }
+
+    private:
+
+        bool resetBusAfterError( uint8_t _i2cAddress ) {
+            // tracked device: once per failed attempt, attempts are spaced by its backoff
+            // not tracked (table full): every recoveryThrottleInMs
+            uint32_t now = millis();
+            if ( lastErrorDevice != nullptr ) {
+                lastErrorDevice->recoveries++;
+            } else {
+                if ( now - lastRecovery <= recoveryThrottleInMs ) return false;
+            }
+            lastRecovery = now;
+
+            //Serial.println( "RECO: " );
+            //if ( lastError != ERR_I2C_OK )
+            //   Serial.printf( "   Last Error = %s\n", errorMessage( lastError ) );
+
+            restartBus( _i2cAddress );
+            lastError = ERR_I2C_OK;
+            recoveredDevice = lastErrorDevice;
+            recoveryPending = true;
+            lastErrorDevice = nullptr;
+            invalidateShadow();
+            return true;
+        }
 
         #if defined(ARDUINO_ARCH_AVR)
 
-            bool recoverIfHasError( uint8_t _i2cAddress ) {
-                if ( lastError == ERR_I2C_OK )
-                    return false;
+            void restartBus( uint8_t _i2cAddress ) {
+                // compute existing frequency if not set thru setFrequency()
+                // https://github.com/arduino/ArduinoCore-avr/blob/master/libraries/Wire/src/utility/twi.c
+                // twi_setFrequency()
+                // Frequency = CPU Clock Frequency / (16 + (2 * TWBR))
+                // TWBR = ((F_CPU / frequency) - 16) / 2;
+                uint32_t freq = _frequency != 0 ? _frequency : F_CPU / (16 + (2 * TWBR));
+
+                // need _wire->end() to recover
+                //    ERROR: 2 NACK    = no
+                //    ERROR: 4 TIMEOUT = yes
+                _wire->end();
+                clearBus();
+                _wire->begin( _i2cAddress );
+                _wire->setClock( freq );
+                _wire->clearWireTimeoutFlag();
+                _wire->clearWriteError();
+            }
 
-                // try to recover every recoveryThrottleInMs only
-                uint32_t now = millis();
-                if ( now - lastRecovery > recoveryThrottleInMs ) {
-                    lastRecovery = now;
-                    
-                    // Serial.print( "RECO: " );
-                    // Serial.println( errorMessage( lastError ) );
-
-                    // compute existing frequency since it was not stored
-                    // https://github.com/arduino/ArduinoCore-avr/blob/master/libraries/Wire/src/utility/twi.c
-                    // twi_setFrequency()
-                    // Frequency = CPU Clock Frequency / (16 + (2 * TWBR))
-                    // TWBR = ((F_CPU / frequency) - 16) / 2;
-                    uint32_t freq = F_CPU / (16 + (2 * TWBR));
-
-                    //Serial.print( "freq = " );
-                    //Serial.println( freq );
-                    
-                    // need _wire->end() to recover
-                    //    ERROR: 2 NACK    = no
-                    //    ERROR: 4 TIMEOUT = yes
-                    _wire->end();
-                    _wire->begin( _i2cAddress );
-                    _wire->setClock( freq );
-                    
-                    lastError = ERR_I2C_OK;
-                    _wire->clearWireTimeoutFlag();
-                    _wire->clearWriteError();
-                    return true;
+        #else
+
+            void restartBus( uint8_t _i2cAddress ) {
+                if ( sdaPin != 0xFF ) {
+                    // release pins from Wire before bit-banging
+                    #if !defined(ARDUINO_ARCH_ESP8266)
+                        _wire->end();
+                    #endif
+                    clearBus();
                 }
-                return false;
+                #if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+                    if ( sdaPin != 0xFF )
+                        _wire->begin( (int) sdaPin, (int) sclPin );
+                    else
+                        _wire->begin();
+                #else
+                    _wire->begin();
+                #endif
+                if ( _frequency != 0 ) _wire->setClock( _frequency );
+                _wire->clearWriteError();
             }
 
-        #else
+        #endif
 
-            bool recoverIfHasError( uint8_t _i2cAddress ) {
-                if ( lastError == ERR_I2C_OK )
-                    return false;
-                
-                // try to recover every recoveryThrottleInMs only
-                uint32_t now = millis();
-                if ( now - lastRecovery > recoveryThrottleInMs ) {
-                    lastRecovery = now;
+        void clearBus() {
+            // https://www.nxp.com/docs/en/user-guide/UM10204.pdf 3.1.16 Bus clear
+            // device holding SDA low is waiting for clocks to finish its byte
+            // open drain: drive low or release to pull-up
+            if ( sdaPin == 0xFF ) return;
+            const uint8_t halfClockInUs = 5;    // 100kHz
+            pinMode( sdaPin, INPUT_PULLUP );
+            pinMode( sclPin, INPUT_PULLUP );
+            delayMicroseconds( halfClockInUs );
+            for( uint8_t i = 0 ; i < 9 && digitalRead( sdaPin ) == LOW ; i++ ) {
+                digitalWrite( sclPin, LOW );
+                pinMode( sclPin, OUTPUT );
+                delayMicroseconds( halfClockInUs );
+                pinMode( sclPin, INPUT_PULLUP );
+                delayMicroseconds( halfClockInUs );
+                // clock stretching
+                for( uint8_t j = 0 ; j < 20 && digitalRead( sclPin ) == LOW ; j++ )
+                    delayMicroseconds( halfClockInUs );
+            }
+            // STOP: SDA low to high while SCL is high
+            digitalWrite( sclPin, LOW );
+            pinMode( sclPin, OUTPUT );
+            digitalWrite( sdaPin, LOW );
+            pinMode( sdaPin, OUTPUT );
+            delayMicroseconds( halfClockInUs );
+            pinMode( sclPin, INPUT_PULLUP );
+            delayMicroseconds( halfClockInUs );
+            pinMode( sdaPin, INPUT_PULLUP );
+            delayMicroseconds( halfClockInUs );
+            busClears++;
+        }
 
-                    //Serial.println( "RECO: " );
-                    //if ( lastError != ERR_I2C_OK )
-                    //   Serial.printf( "   Last Error = %s\n", errorMessage( lastError ) );
+    //
+    // SHADOW REGISTERS
+    //
+    public:
 
-                    _wire->begin();
-                    _wire->clearWriteError();
-                    lastError = ERR_I2C_OK;
-                    return true;
+        class shadowTable {
+            public:
+                shadowTable *next = nullptr;
+                uint8_t  i2cAddress;
+                uint8_t  firstReg;
+                uint8_t  count;
+                bool     isDevice;      // no registers, value is whole device (ex. PCF8574 port)
+                uint8_t *values;
+                uint8_t *validBits;
+
+                inline bool covers( uint8_t reg ) { return (uint8_t) ( reg - firstReg ) < count; }
+                inline bool isValid( uint8_t reg ) {
+                    uint8_t i = reg - firstReg;
+                    return validBits[ i >> 3 ] & ( 1 << ( i & 7 ) );
+                }
+                inline uint8_t get( uint8_t reg ) { return values[ (uint8_t) ( reg - firstReg ) ]; }
+                inline void set( uint8_t reg, uint8_t value ) {
+                    uint8_t i = reg - firstReg;
+                    values[i] = value;
+                    validBits[ i >> 3 ] |= ( 1 << ( i & 7 ) );
+                }
+                inline void invalidate( uint8_t reg ) {
+                    uint8_t i = reg - firstReg;
+                    validBits[ i >> 3 ] &= ~( 1 << ( i & 7 ) );
+                }
+                inline void invalidate() { memset( validBits, 0, ( count + 7 ) / 8 ); }
+        };
+
+        template<uint8_t COUNT>
+        class shadowRegisters : public shadowTable {
+                uint8_t valueStorage[ COUNT ];
+                uint8_t validStorage[ ( COUNT + 7 ) / 8 ];
+            public:
+                // registers firstReg .. firstReg + COUNT - 1 of device
+                shadowRegisters( uint8_t i2cAddress, uint8_t firstReg ) {
+                    init( i2cAddress, firstReg, false );
+                }
+                // device without registers
+                shadowRegisters( uint8_t i2cAddress ) {
+                    init( i2cAddress, 0, true );
                 }
-                return false;
+            private:
+                void init( uint8_t i2cAddress, uint8_t firstReg, bool isDevice ) {
+                    this->i2cAddress = i2cAddress;
+                    this->firstReg   = firstReg;
+                    this->count      = COUNT;
+                    this->isDevice   = isDevice;
+                    values    = valueStorage;
+                    validBits = validStorage;
+                    invalidate();
+                }
+        };
+
+        uint32_t shadowHits   = 0;      // writes skipped
+        uint32_t shadowMisses = 0;      // shadowed writes sent
+
+        inline void resetShadowCounters() { shadowHits = 0; shadowMisses = 0; }
+
+        void attachShadow( shadowTable &table ) {
+            table.next = shadowList;
+            shadowList = &table;
+        }
+
+        void invalidateShadow() {
+            for( shadowTable *t = shadowList ; t != nullptr ; t = t->next )
+                t->invalidate();
+        }
+
+    private:
+
+        shadowTable *shadowList = nullptr;
+
+        shadowTable *findShadow( uint8_t _i2cAddress, uint8_t reg, bool isDevice ) {
+            for( shadowTable *t = shadowList ; t != nullptr ; t = t->next ) {
+                if ( t->i2cAddress == _i2cAddress && t->isDevice == isDevice && t->covers( reg ) )
+                    return t;
+            }
+            return nullptr;
+        }
+
+        bool shadowMatches( uint8_t _i2cAddress, uint8_t reg, const uint8_t *data, uint16_t length, bool isDevice ) {
+            // true if every byte is shadowed and unchanged
+            if ( shadowList == nullptr ) return false;
+            for( uint16_t i = 0 ; i < length ; i++, reg++ ) {
+                shadowTable *t = findShadow( _i2cAddress, reg, isDevice );
+                if ( t == nullptr || !t->isValid( reg ) || t->get( reg ) != data[i] ) return false;
+            }
+            return true;
+        }
+
+        bool shadowStore( uint8_t _i2cAddress, uint8_t reg, const uint8_t *data, uint16_t length, bool isDevice, bool sent ) {
+            // after write, or invalidate if not known what device has, returns true if anything is shadowed
+            if ( shadowList == nullptr ) return false;
+            bool found = false;
+            for( uint16_t i = 0 ; i < length ; i++, reg++ ) {
+                shadowTable *t = findShadow( _i2cAddress, reg, isDevice );
+                if ( t == nullptr ) continue;
+                found = true;
+                if ( sent ) t->set( reg, data[i] ); else t->invalidate( reg );
+            }
+            return found;
+        }
+
+        inline ERROR_NO shadowWriteResult( uint8_t _i2cAddress, uint8_t reg, const uint8_t *data, uint16_t length, bool isDevice, ERROR_NO r ) {
+            if ( r == ERR_I2C_OFFLINE ) return r;  // nothing sent
+            if ( shadowStore( _i2cAddress, reg, data, length, isDevice, r == ERR_I2C_OK ) && r == ERR_I2C_OK )
+                shadowMisses++;
+            return r;
+        }
+
+    //
+    // TRACE
+    //
+    public:
+
+        static const uint8_t traceDataBytes = 4;
+
+        struct traceEntry {
+            uint32_t startInUs;
+            uint32_t durationInUs;
+            uint16_t length;            // bytes written, or bytes requested if read
+            uint8_t  i2cAddress;        // bit 7 set if read
+            ERROR_NO error;
+            uint8_t  dataCount;         // bytes in data[]
+            uint8_t  data[ traceDataBytes ];
+
+            inline bool isRead() { return i2cAddress & 0x80; }
+            inline uint8_t getI2cAddress() { return i2cAddress & 0x7F; }
+        };
+
+        #if defined(SP_I2CHELPER_TRACE)
+
+            static const uint16_t traceSize = SP_I2CHELPER_TRACE;
+
+            bool     traceEnabled = true;
+            uint32_t traceTotal   = 0;
+
+            void clearTrace() {
+                traceNext = 0;
+                traceTotal = 0;
+                traceOpen = nullptr;
+                traceLastRead = nullptr;
+            }
+
+            inline uint16_t getTraceCount() {
+                return traceTotal < traceSize ? traceTotal : traceSize;
+            }
+
+            inline traceEntry &getTraceAt( uint16_t index ) {
+                // 0 is oldest
+                return traceBuffer[ ( traceNext + traceSize - getTraceCount() + index ) % traceSize ];
             }
 
+        #else
+
+            static const uint16_t traceSize = 0;
+            static const uint32_t traceTotal = 0;
+
+            inline void clearTrace() {}
+            inline uint16_t getTraceCount() { return 0; }
+
         #endif
 
-        inline bool recoverIfHasError() {
-            return recoverIfHasError( _defaultI2cAddress );
+        void dumpTrace( Print &out ) {
+            // little endian
+            //   "I2CT", version 2, entry size, entry count (2), total recorded (4), dump time in us (4)
+            //   entries oldest first: start (4), duration (4), address|read, length (2), error, dataCount, data (4)
+            //   version 1 had 1 byte length
+            out.write( (const uint8_t *) "I2CT", 4 );
+            out.write( (uint8_t) 2 );
+            out.write( (uint8_t) ( 13 + traceDataBytes ) );
+            uint16_t count = getTraceCount();
+            dumpValue( out, count, 2 );
+            dumpValue( out, traceTotal, 4 );
+            dumpValue( out, micros(), 4 );
+            #if defined(SP_I2CHELPER_TRACE)
+                for( uint16_t i = 0 ; i < count ; i++ ) {
+                    traceEntry &e = getTraceAt( i );
+                    dumpValue( out, e.startInUs, 4 );
+                    dumpValue( out, e.durationInUs, 4 );
+                    out.write( e.i2cAddress );
+                    dumpValue( out, e.length, 2 );
+                    out.write( e.error );
+                    out.write( e.dataCount );
+                    out.write( e.data, traceDataBytes );
+                }
+            #endif
         }
 
+    private:
+
+        static void dumpValue( Print &out, uint32_t value, uint8_t bytes ) {
+            for( uint8_t i = 0 ; i < bytes ; i++, value >>= 8 )
+                out.write( (uint8_t) value );
+        }
+
+        #if defined(SP_I2CHELPER_TRACE)
+
+            traceEntry  traceBuffer[ traceSize ];
+            uint16_t    traceNext     = 0;
+            traceEntry *traceOpen     = nullptr;    // transfer in progress
+            traceEntry *traceLastRead = nullptr;    // receives bytes read
+
+            void traceBegin( uint8_t _i2cAddress, bool isRead, uint16_t length ) {
+                if ( !traceEnabled ) return;
+                traceEntry *e = &traceBuffer[ traceNext ];
+                traceNext = ( traceNext + 1 ) % traceSize;
+                traceTotal++;
+                e->startInUs    = micros();
+                e->durationInUs = 0;
+                e->i2cAddress   = _i2cAddress | ( isRead ? 0x80 : 0 );
+                e->length       = length;
+                e->error        = ERR_I2C_OK;
+                e->dataCount    = 0;
+                traceOpen       = e;
+                traceLastRead   = isRead ? e : nullptr;
+            }
+
+            inline void traceWrite( const uint8_t *data, uint16_t count ) {
+                if ( traceOpen == nullptr ) return;
+                traceOpen->length += count;
+                while( count-- > 0 && traceOpen->dataCount < traceDataBytes )
+                    traceOpen->data[ traceOpen->dataCount++ ] = *data++;
+            }
+
+            inline void traceRead( uint8_t value ) {
+                if ( traceLastRead == nullptr || traceLastRead->dataCount >= traceDataBytes ) return;
+                traceLastRead->data[ traceLastRead->dataCount++ ] = value;
+            }
+
+            inline void traceEnd( ERROR_NO error ) {
+                if ( traceOpen == nullptr ) return;
+                traceOpen->durationInUs = micros() - traceOpen->startInUs;
+                traceOpen->error = error;
+                traceOpen = nullptr;
+            }
+
+            inline void traceOffline( uint8_t _i2cAddress, bool isRead ) {
+                // not sent, recorded to show calls skipped
+                traceBegin( _i2cAddress, isRead, 0 );
+                traceEnd( ERR_I2C_OFFLINE );
+            }
+
+        #else
+
+            inline void traceBegin( uint8_t _i2cAddress, bool isRead, uint16_t length ) {}
+            inline void traceWrite( const uint8_t *data, uint16_t count ) {}
+            inline void traceRead( uint8_t value ) {}
+            inline void traceEnd( ERROR_NO error ) {}
+            inline void traceOffline( uint8_t _i2cAddress, bool isRead ) {}
+
+        #endif
+
     //
     // WRAPPERS
     //
-    
-        inline bool endTransmission() {
+    public:
+
+        inline bool beginTransmission( uint8_t _i2cAddress ) {
+            if ( !isDeviceReady( _i2cAddress ) ) { traceOffline( _i2cAddress, false ); return false; }
+            traceBegin( _i2cAddress, false, 0 );
+            _wire->beginTransmission( _i2cAddress );
+            return true;
+        }
+
+        inline bool endTransmission( bool transferDone = true ) {
+            // device is back online only when whole transfer is done, not after register address of a read
             auto err = _wire->endTransmission();
             if ( err != ERR_I2C_OK ) { RecordError( err ); return false; }
             if ( !CheckAndRecordError() ) return false;
+            if ( transferDone ) RecordSuccess(); else traceEnd( ERR_I2C_OK );
             return true;
         }
 
         inline bool write( uint8_t data ) {
+            traceWrite( &data, 1 );
             size_t bytesWritten = _wire->write( data );
             auto err = _wire->getWriteError();
             if ( err != 0 ) { RecordError( ERR_I2C_WRITE ); return false; }
@@ -480,7 +1036,7 @@ class i2cHelper {
             return true;
         }
 
-        inline bool available( uint8_t length ) {
+        inline bool available( uint8_t length, bool transferDone = true ) {
             if ( _wire->available() < length ) {
                 uint32_t start = millis();
                 while ( _wire->available() < length ) {
@@ -488,7 +1044,9 @@ class i2cHelper {
                     if ( !CheckAndRecordError() ) return false;
                 }
             }
-            return CheckAndRecordError();
+            if ( !CheckAndRecordError() ) return false;
+            if ( transferDone ) RecordSuccess(); else traceEnd( ERR_I2C_OK );
+            return true;
         }
 
         // #if defined(ESP32)
@@ -541,6 +1099,8 @@ class i2cHelper {
         // #endif
 
         inline bool requestFrom( uint8_t _i2cAddress, uint8_t length ) {
+            if ( !isDeviceReady( _i2cAddress ) ) { traceOffline( _i2cAddress, true ); return false; }
+            traceBegin( _i2cAddress, true, length );
             size_t bytesArrived = _wire->requestFrom( _i2cAddress, length );
             if ( !CheckAndRecordError() ) return false;
             // NEEDED FOR ARDUINO / ESP32
@@ -548,17 +1108,25 @@ class i2cHelper {
             return true;
         }
         
+    private:
+
+        inline uint8_t read() {
+            uint8_t value = _wire->read();
+            traceRead( value );
+            return value;
+        }
+
     //
     // READ CORE
     //
     private:
 
-        ERROR_NO readBytesCore( uint8_t _i2cAddress, uint8_t dataAddr, uint8_t length ) {    
-            _wire->beginTransmission( _i2cAddress );
+        ERROR_NO readBytesCore( uint8_t _i2cAddress, uint8_t dataAddr, uint8_t length, bool transferDone = true ) {    
+            if ( !beginTransmission( _i2cAddress ) ) return ERR_I2C_OFFLINE;
             if ( !write( dataAddr ) ) return lastError;
-            if ( !endTransmission() ) return lastError;
+            if ( !endTransmission( false ) ) return lastError;
             if ( !requestFrom( _i2cAddress, length ) ) return lastError;
-            if ( !available( length ) ) return lastError;
+            if ( !available( length, transferDone ) ) return lastError;
             return ERR_I2C_OK;
         }
 
@@ -570,7 +1138,7 @@ class i2cHelper {
         ERROR_NO readOneByte_i2c( uint8_t _i2cAddress, uint8_t dataAddr, uint8_t & result ) {
             ERROR_NO r = readBytesCore( _i2cAddress, dataAddr, 1 );
             if ( r != ERR_I2C_OK ) { return r; }
-            result = _wire->read();
+            result = read();
             return ERR_I2C_OK;
         }
 
@@ -589,6 +1157,34 @@ class i2cHelper {
             return readOneByte_i2c( _defaultI2cAddress, dataAddr );
         }
 
+    //
+    // READ CONSECUTIVE REGISTERS
+    //
+    public:
+
+        ERROR_NO readBytes_i2c( uint8_t _i2cAddress, uint8_t dataAddr, uint8_t *buffer, uint16_t length ) {
+            // set register once, then as many requests as wire buffer needs
+            // requests are limited to 255 bytes, even if wire buffer is 256
+            const uint16_t chunk = wireBufferLength < 255 ? wireBufferLength : 255;
+            if ( length == 0 ) return ERR_I2C_OK;
+            uint16_t count = length < chunk ? length : chunk;
+            ERROR_NO r = readBytesCore( _i2cAddress, dataAddr, count, count == length );
+            while( true ) {
+                if ( r != ERR_I2C_OK ) { return r; }
+                for( uint16_t i = 0 ; i < count ; i++ )
+                    *buffer++ = read();
+                length -= count;
+                if ( length == 0 ) return ERR_I2C_OK;
+                count = length < chunk ? length : chunk;
+                if ( !requestFrom( _i2cAddress, count ) ) return lastError;
+                if ( !available( count, count == length ) ) return lastError;
+            }
+        }
+
+        inline ERROR_NO readBytes( uint8_t dataAddr, uint8_t *buffer, uint16_t length ) {
+            return readBytes_i2c( _defaultI2cAddress, dataAddr, buffer, length );
+        }
+
     //
     // READ 2 BYTES SEPARATELY
     //
@@ -598,6 +1194,8 @@ class i2cHelper {
             // read 2 bytes from different addresses, assemble to result
             //    lowDataAddr  is LSB (low byte)
             //    highDataAddr is MSB (high byte)
+            //    always 2 reads, even if consecutive: not all devices auto-increment
+            //    (ex. ST sensors need MSB of register address set), use readBytes() for a burst
             uint8_t lowByte, highByte;
             ERROR_NO r = readOneByte_i2c( _i2cAddress, lowDataAddr, lowByte );
             if ( r != ERR_I2C_OK ) { return r; }
@@ -611,7 +1209,7 @@ class i2cHelper {
             uint16_t result;
             ERROR_NO r = readTwoBytes_DiffAddr_i2c( _i2cAddress, lowDataAddr, highDataAddr, result );
             if ( r != ERR_I2C_OK ) { return 0; }
-            return ERR_I2C_OK;
+            return result;
         }
 
         inline ERROR_NO readTwoBytes_DiffAddr( uint8_t lowDataAddr, uint8_t highDataAddr, uint16_t & result ) {
@@ -633,8 +1231,8 @@ class i2cHelper {
             //    2nd byte to arrive is LSB (low byte)
             ERROR_NO r = readBytesCore( _i2cAddress, dataAddr, 2 );
             if ( r != ERR_I2C_OK ) { return r; }
-            uint8_t highByte = _wire->read();
-            uint8_t lowByte  = _wire->read();
+            uint8_t highByte = read();
+            uint8_t lowByte  = read();
             result = ( highByte << 8 ) | lowByte;
             return ERR_I2C_OK;
         }
@@ -645,8 +1243,8 @@ class i2cHelper {
             //    2nd byte to arrive is MSB (high byte)
             ERROR_NO r = readBytesCore( _i2cAddress, dataAddr, 2 );
             if ( r != ERR_I2C_OK ) { return r; }
-            uint8_t lowByte  = _wire->read();
-            uint8_t highByte = _wire->read();
+            uint8_t lowByte  = read();
+            uint8_t highByte = read();
             result = ( highByte << 8 ) | lowByte;
             return ERR_I2C_OK;
         }
@@ -687,26 +1285,142 @@ class i2cHelper {
     public:
 
         ERROR_NO writeOneByte_i2c( uint8_t _i2cAddress, uint8_t data ) {
-            _wire->beginTransmission( _i2cAddress );
-            if ( !write( data ) ) return lastError;
-            if ( !endTransmission() ) return lastError;
-            return ERR_I2C_OK;
+            if ( shadowMatches( _i2cAddress, 0, &data, 1, true ) ) { shadowHits++; return ERR_I2C_OK; }
+            return shadowWriteResult( _i2cAddress, 0, &data, 1, true, writeOneByteCore( _i2cAddress, data ) );
         }
 
         inline ERROR_NO writeOneByte( uint8_t data ) {
             return writeOneByte_i2c( _defaultI2cAddress, data );
         }
 
+        inline ERROR_NO writeBytes_i2c( uint8_t _i2cAddress, const uint8_t *data, uint16_t length ) {
+            return writeSequence( _i2cAddress, data, length, true );
+        }
+
+        inline ERROR_NO writeBytes( const uint8_t *data, uint16_t length ) {
+            return writeBytes_i2c( _defaultI2cAddress, data, length );
+        }
+
         ERROR_NO writeAddrAndData_i2c( uint8_t _i2cAddress, uint8_t dataAddr, uint8_t dataValue ) {
-            _wire->beginTransmission( _i2cAddress );
+            if ( shadowMatches( _i2cAddress, dataAddr, &dataValue, 1, false ) ) { shadowHits++; return ERR_I2C_OK; }
+            return shadowWriteResult( _i2cAddress, dataAddr, &dataValue, 1, false, writeAddrAndDataCore( _i2cAddress, dataAddr, dataValue ) );
+        }
+
+        inline ERROR_NO writeAddrAndData( uint8_t dataAddr, uint8_t dataValue ) {
+            return writeAddrAndData_i2c( _defaultI2cAddress, dataAddr, dataValue );
+        }
+
+        ERROR_NO writeAddrAndBytes_i2c( uint8_t _i2cAddress, uint8_t dataAddr, const uint8_t *data, uint16_t length ) {
+            // skipped only if all bytes are unchanged
+            if ( length > 0 && shadowMatches( _i2cAddress, dataAddr, data, length, false ) ) { shadowHits++; return ERR_I2C_OK; }
+            return shadowWriteResult( _i2cAddress, dataAddr, data, length, false, writeAddrAndBytesCore( _i2cAddress, dataAddr, data, length ) );
+        }
+
+        inline ERROR_NO writeAddrAndBytes( uint8_t dataAddr, const uint8_t *data, uint16_t length ) {
+            return writeAddrAndBytes_i2c( _defaultI2cAddress, dataAddr, data, length );
+        }
+
+    //
+    // READ-MODIFY-WRITE
+    //
+    public:
+
+        ERROR_NO updateBits_i2c( uint8_t _i2cAddress, uint8_t dataAddr, uint8_t mask, uint8_t value ) {
+            // bits in mask are set to value, current value from shadow if known
+            uint8_t current;
+            shadowTable *t = findShadow( _i2cAddress, dataAddr, false );
+            if ( t != nullptr && t->isValid( dataAddr ) ) {
+                current = t->get( dataAddr );
+            } else {
+                ERROR_NO r = readOneByte_i2c( _i2cAddress, dataAddr, current );
+                if ( r != ERR_I2C_OK ) { return r; }
+                if ( t != nullptr ) t->set( dataAddr, current );
+            }
+            return writeAddrAndData_i2c( _i2cAddress, dataAddr, ( current & ~mask ) | ( value & mask ) );
+        }
+
+        inline ERROR_NO setBits_i2c( uint8_t _i2cAddress, uint8_t dataAddr, uint8_t mask ) {
+            return updateBits_i2c( _i2cAddress, dataAddr, mask, 0xFF );
+        }
+
+        inline ERROR_NO clearBits_i2c( uint8_t _i2cAddress, uint8_t dataAddr, uint8_t mask ) {
+            return updateBits_i2c( _i2cAddress, dataAddr, mask, 0x00 );
+        }
+
+        inline ERROR_NO updateBits( uint8_t dataAddr, uint8_t mask, uint8_t value ) {
+            return updateBits_i2c( _defaultI2cAddress, dataAddr, mask, value );
+        }
+
+        inline ERROR_NO setBits( uint8_t dataAddr, uint8_t mask ) {
+            return setBits_i2c( _defaultI2cAddress, dataAddr, mask );
+        }
+
+        inline ERROR_NO clearBits( uint8_t dataAddr, uint8_t mask ) {
+            return clearBits_i2c( _defaultI2cAddress, dataAddr, mask );
+        }
+
+    //
+    // WRITE CORE
+    //
+    private:
+
+        ERROR_NO writeOneByteCore( uint8_t _i2cAddress, uint8_t data ) {
+            if ( !beginTransmission( _i2cAddress ) ) return ERR_I2C_OFFLINE;
+            if ( !write( data ) ) return lastError;
+            if ( !endTransmission() ) return lastError;
+            return ERR_I2C_OK;
+        }
+
+        ERROR_NO writeSequence( uint8_t _i2cAddress, const uint8_t *data, uint16_t length, bool transferDone ) {
+            // device shadow ends with last byte, sequence itself is always sent
+            // transferDone false if a read follows, see i2cQueue
+            ERROR_NO r = writeBytesCore( _i2cAddress, data, length, transferDone );
+            if ( length > 0 ) shadowStore( _i2cAddress, 0, data + length - 1, 1, true, r == ERR_I2C_OK );
+            return r;
+        }
+
+        ERROR_NO writeBytesCore( uint8_t _i2cAddress, const uint8_t *data, uint16_t length, bool transferDone ) {
+            // send bytes with as few transmissions as possible
+            // split if longer than wire buffer
+            while( length > 0 ) {
+                uint16_t count = length < wireBufferLength ? length : wireBufferLength;
+                if ( !beginTransmission( _i2cAddress ) ) return ERR_I2C_OFFLINE;
+                traceWrite( data, count );
+                size_t bytesWritten = _wire->write( data, count );
+                if ( _wire->getWriteError() != 0 || bytesWritten != count ) { RecordError( ERR_I2C_WRITE ); return lastError; }
+                if ( !CheckAndRecordError() ) return lastError;
+                if ( !endTransmission( transferDone && count == length ) ) return lastError;
+                data += count;
+                length -= count;
+            }
+            return ERR_I2C_OK;
+        }
+
+        ERROR_NO writeAddrAndDataCore( uint8_t _i2cAddress, uint8_t dataAddr, uint8_t dataValue ) {
+            if ( !beginTransmission( _i2cAddress ) ) return ERR_I2C_OFFLINE;
             if ( !write( dataAddr ) ) return lastError;
             if ( !write( dataValue ) ) return lastError;
             if ( !endTransmission() ) return lastError;
             return ERR_I2C_OK;
         }
 
-        inline ERROR_NO writeAddrAndData( uint8_t dataAddr, uint8_t dataValue ) {
-            return writeAddrAndData_i2c( _defaultI2cAddress, dataAddr, dataValue );
+        ERROR_NO writeAddrAndBytesCore( uint8_t _i2cAddress, uint8_t dataAddr, const uint8_t *data, uint16_t length ) {
+            // register address + data in one transmission
+            // split if longer than wire buffer, next part starts at following register
+            do {
+                uint16_t count = length < wireBufferLength - 1 ? length : wireBufferLength - 1;
+                if ( !beginTransmission( _i2cAddress ) ) return ERR_I2C_OFFLINE;
+                if ( !write( dataAddr ) ) return lastError;
+                traceWrite( data, count );
+                size_t bytesWritten = _wire->write( data, count );
+                if ( _wire->getWriteError() != 0 || bytesWritten != count ) { RecordError( ERR_I2C_WRITE ); return lastError; }
+                if ( !CheckAndRecordError() ) return lastError;
+                if ( !endTransmission( count == length ) ) return lastError;
+                data += count;
+                dataAddr += count;
+                length -= count;
+            } while( length > 0 );
+            return ERR_I2C_OK;
         }
 
 };
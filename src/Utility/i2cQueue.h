@@ -0,0 +1,279 @@
+//  I2C Transaction Queue
+//  ---------------------
+//  - submit transactions, they are sent later by poll() or by a background task
+//  - with background task, caller is not blocked by a slow or disconnected device
+//  - with poll() from loop(), one transaction per call
+//    loop() is blocked for that one transfer only, not for the whole queue
+//  - uses i2cHelper for sending, errors are still recorded to i2cHelper::lastError
+//    offline devices fail at once without using the bus, see i2cHelper Recovery
+//
+//  To Use
+//
+//      i2cHelper helper( 0x36 );
+//      i2cQueue queue( helper );
+//
+//      uint8_t reg = 0x0C;
+//      uint8_t data[2];
+//      i2cQueue::transaction angle;            // owned by caller, must stay alive until done
+//      angle.i2cAddress  = 0x36;
+//      angle.writeData   = &reg;
+//      angle.writeLength = 1;
+//      angle.readBuffer  = data;
+//      angle.readLength  = 2;
+//
+//      void loop() {
+//          if ( angle.isDone() ) {
+//              if ( angle.result == i2cHelper::ERR_I2C_OK ) ... use data
+//              queue.submit( angle );          // next sample
+//          }
+//          queue.poll();                       // one transaction
+//          queue.recoverIfHasError();
+//          ... rest of loop
+//      }
+//
+//  Transaction
+//
+//      i2cAddress                      device
+//      writeData, writeLength          sent first, ex. register address, split if longer than wire buffer
+//      readBuffer, readLength          then read, up to wire buffer length
+//      onComplete( transaction & )     optional, called from poll() or background task
+//      userData                        for use of onComplete
+//
+//      result                          ERROR_NO, valid once isDone()
+//      isDone()                        completed or never submitted
+//
+//      no write and no read is same as i2cHelper::verify()
+//
+//  Functions
+//
+//      bool    submit( transaction & )     false if queue is full or transaction is still pending
+//      bool    poll()                      send one transaction, returns true if more are pending
+//      bool    recoverIfHasError()         same as i2cHelper, ignored while background task runs
+//      uint8_t getPendingCount()
+//      bool    isEmpty()
+//      uint8_t queueSize                   SP_I2CQUEUE_SIZE, default 8
+//
+//  Background Task
+//
+//      bool startTask( core, idleInMs, stackSize, priority )
+//      void stopTask()
+//      - ESP32 FreeRTOS task or std::thread on host builds, not supported on other platforms
+//      - submit() from one task only, the queue is single producer/single consumer
+//      - do not use the same i2cHelper/Wire from other tasks while running
+//      - task does the i2c error recovery, do not call i2cHelper::recoverIfHasError()
+//
+//  Note
+//
+//      Wire's endTransmission()/requestFrom() block until the transfer is done
+//      when requestFrom() returns, data is already in Wire's buffer
+//      so only moving the transfers to another task keeps the caller from waiting
+
+#pragma once
+
+#if defined(ESP32)
+    #include <Arduino.h>
+#endif
+#include <stdint.h>
+
+#include <Utility/i2cHelper.h>
+#include <Utility/spAtomic.h>
+
+#if !defined(ARDUINO)
+    #include <thread>
+    #include <chrono>
+#endif
+
+namespace StarterPack {
+
+class i2cQueue {
+
+    public:
+
+        #if defined(SP_I2CQUEUE_SIZE)
+            static const uint8_t queueSize = SP_I2CQUEUE_SIZE;
+        #else
+            static const uint8_t queueSize = 8;
+        #endif
+
+        struct transaction {
+            uint8_t        i2cAddress  = 0;
+            const uint8_t *writeData   = nullptr;
+            uint8_t        writeLength = 0;
+            uint8_t       *readBuffer  = nullptr;
+            uint8_t        readLength  = 0;
+
+            void (*onComplete)( transaction &t ) = nullptr;
+            void          *userData    = nullptr;
+
+            volatile ERROR_NO result   = i2cHelper::ERR_I2C_OK;
+            spAtomic<bool> done { true };
+
+            inline bool isDone() { return done.load(); }
+        };
+
+    private:
+
+        i2cHelper *helper;
+
+        transaction *slots[ queueSize ];
+        spAtomic<uint8_t> head { 0 };   // next to send, owned by poll()
+        spAtomic<uint8_t> tail { 0 };   // next free, owned by submit()
+
+    public:
+
+        i2cQueue( i2cHelper &helper ) : helper( &helper ) {}
+
+        bool submit( transaction &t ) {
+            if ( !t.isDone() ) return false;
+            if ( t.readLength > i2cHelper::wireBufferLength ) {
+                t.result = i2cHelper::ERR_I2C_BUFFER;
+                return false;
+            }
+            uint8_t next = ( tail.load() + 1 ) % queueSize;
+            if ( next == head.load() ) return false;
+            t.result = i2cHelper::ERR_I2C_OK;
+            t.done.store( false );
+            slots[ tail.load() ] = &t;
+            tail.store( next );
+            return true;
+        }
+
+        inline uint8_t getPendingCount() {
+            return ( tail.load() + queueSize - head.load() ) % queueSize;
+        }
+
+        inline bool isEmpty() { return head.load() == tail.load(); }
+
+    //
+    // POLL
+    //
+    public:
+
+        bool poll() {
+            // one transaction per call
+            uint8_t h = head.load();
+            if ( h == tail.load() ) return false;
+            transaction &t = *slots[h];
+            complete( t, send( t ) );
+            return !isEmpty();
+        }
+
+        bool recoverIfHasError() {
+            // background task recovers by itself
+            if ( taskRunning ) return false;
+            return helper->recoverIfHasError();
+        }
+
+    private:
+
+        ERROR_NO send( transaction &t ) {
+            if ( !helper->isDeviceReady( t.i2cAddress ) )
+                return i2cHelper::ERR_I2C_OFFLINE;
+            if ( t.writeLength == 0 && t.readLength == 0 )
+                return helper->verifyWithError( t.i2cAddress );
+            if ( t.writeLength != 0 ) {
+                // online again only if read also succeeds
+                ERROR_NO r = helper->writeSequence( t.i2cAddress, t.writeData, t.writeLength, t.readLength == 0 );
+                if ( r != i2cHelper::ERR_I2C_OK || t.readLength == 0 ) return r;
+            }
+            // data is in Wire's buffer once requestFrom() returns
+            if ( !helper->requestFrom( t.i2cAddress, t.readLength ) ) return helper->lastError;
+            helper->RecordSuccess();
+            for( uint8_t i = 0 ; i < t.readLength ; i++ )
+                t.readBuffer[i] = helper->read();
+            return i2cHelper::ERR_I2C_OK;
+        }
+
+        void complete( transaction &t, ERROR_NO r ) {
+            // free slot before callback, so callback may submit again
+            head.store( ( head.load() + 1 ) % queueSize );
+            t.result = r;
+            t.done.store( true );
+            if ( t.onComplete != nullptr ) t.onComplete( t );
+        }
+
+    //
+    // BACKGROUND TASK
+    //
+    private:
+
+        volatile bool taskRunning = false;
+        spAtomic<bool> taskStop { false };
+        uint16_t taskIdleInMs = 1;
+
+        #if defined(ESP32)
+            TaskHandle_t taskHandle = nullptr;
+            spAtomic<bool> taskDone { false };
+        #elif !defined(ARDUINO)
+            std::thread *taskThread = nullptr;
+        #endif
+
+        void taskLoop() {
+            // rest only when queue is empty
+            // task owns the bus, so it also recovers from errors
+            while( !taskStop.load() ) {
+                helper->recoverIfHasError();
+                if ( poll() ) continue;
+                #if defined(ESP32)
+                    vTaskDelay( taskIdleInMs / portTICK_PERIOD_MS + 1 );
+                #elif !defined(ARDUINO)
+                    std::this_thread::sleep_for( std::chrono::milliseconds( taskIdleInMs ) );
+                #endif
+            }
+        }
+
+        #if defined(ESP32)
+            static void taskEntry( void *param ) {
+                i2cQueue *self = (i2cQueue *) param;
+                self->taskLoop();
+                self->taskDone.store( true );
+                vTaskDelete( nullptr );
+            }
+        #endif
+
+    public:
+
+        bool startTask( uint8_t core = 0, uint16_t idleInMs = 1, uint32_t stackSize = 2048, uint8_t priority = 1 ) {
+            if ( taskRunning ) return false;
+            taskIdleInMs = idleInMs;
+            taskStop.store( false );
+            taskRunning = true;
+            #if defined(ESP32)
+                taskDone.store( false );
+                if ( xTaskCreatePinnedToCore( taskEntry, "i2cQueue", stackSize,
+                        this, priority, &taskHandle, core ) != pdPASS ) {
+                    taskHandle = nullptr;
+                    taskRunning = false;
+                    return false;
+                }
+            #elif !defined(ARDUINO)
+                (void) core; (void) stackSize; (void) priority;
+                taskThread = new std::thread( [this]() { taskLoop(); } );
+            #else
+                (void) core; (void) stackSize; (void) priority;
+                taskRunning = false;
+                return false;
+            #endif
+            return true;
+        }
+
+        void stopTask() {
+            // current transaction is finished first
+            if ( !taskRunning ) return;
+            taskStop.store( true );
+            #if defined(ESP32)
+                while( !taskDone.load() ) delay( 1 );
+                taskHandle = nullptr;
+            #elif !defined(ARDUINO)
+                taskThread->join();
+                delete taskThread;
+                taskThread = nullptr;
+            #endif
+            taskRunning = false;
+        }
+
+        inline bool isTaskRunning() { return taskRunning; }
+
+};
+
+}
@@ -0,0 +1,85 @@
+//  Poor Man's Atomic
+//
+//  minimal atomic value for single producer/single consumer handoffs
+//  - std::atomic where available (ESP32, SAMD, host builds)
+//  - AVR has no <atomic>, single core so just disable interrupts
+//
+//  spAtomic<uint8_t> value = 0;
+//
+//  core0:
+//      uint8_t old = value.exchange( 5 );
+//
+//  core1:
+//      if ( value.load() == 5 ) ...
+
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+
+#if !defined(ARDUINO_ARCH_AVR)
+    #include <atomic>
+#endif
+
+namespace StarterPack {
+
+#if !defined(ARDUINO_ARCH_AVR)
+
+template<typename T>
+class spAtomic {
+
+    std::atomic<T> value;
+
+public:
+
+    spAtomic( T initial = 0 ) : value( initial ) {}
+
+    inline T load() {
+        return value.load( std::memory_order_acquire );
+    }
+    inline void store( T newValue ) {
+        value.store( newValue, std::memory_order_release );
+    }
+    inline T exchange( T newValue ) {
+        return value.exchange( newValue, std::memory_order_acq_rel );
+    }
+
+};
+
+#else
+
+template<typename T>
+class spAtomic {
+
+    volatile T value;
+
+public:
+
+    spAtomic( T initial = 0 ) : value( initial ) {}
+
+    // restore previous interrupt state, may be called from ISR
+
+    inline T load() {
+        if ( sizeof( T ) == 1 ) return value;
+        uint8_t sreg = SREG; cli();
+        T r = value;
+        SREG = sreg;
+        return r;
+    }
+    inline void store( T newValue ) {
+        uint8_t sreg = SREG; cli();
+        value = newValue;
+        SREG = sreg;
+    }
+    inline T exchange( T newValue ) {
+        uint8_t sreg = SREG; cli();
+        T r = value;
+        value = newValue;
+        SREG = sreg;
+        return r;
+    }
+
+};
+
+#endif
+
+}